@@ -34,6 +34,22 @@ int USBSerial::_getc() {
 }
 
 
+ssize_t USBSerial::write(const void* buffer, size_t length) {
+    if (!terminal_connected)
+        return 0;
+    const uint8_t *ptr = (const uint8_t *)buffer;
+    size_t sent = 0;
+    while (sent < length) {
+        uint16_t size = length - sent;
+        if (size > MAX_PACKET_SIZE_EPBULK)
+            size = MAX_PACKET_SIZE_EPBULK;
+        if (!send((uint8_t *)ptr + sent, size))
+            break;
+        sent += size;
+    }
+    return sent;
+}
+
 bool USBSerial::writeBlock(uint8_t * buf, uint16_t size) {
     if(size > MAX_PACKET_SIZE_EPBULK) {
         return false;
@@ -120,6 +120,12 @@ public:
 protected:
     virtual bool EP2_OUT_callback();
 
+    // whole buffers go out in as few bulk packets as possible
+    virtual ssize_t write(const void* buffer, size_t length);
+    virtual int _readable() {
+        return available();
+    }
+
 private:
     FunctionPointer rx;
     CircBuffer<uint8_t> buf;
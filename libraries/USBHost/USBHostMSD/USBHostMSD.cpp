@@ -26,6 +26,12 @@
 #define DEVICE_TO_HOST  0x80
 #define HOST_TO_DEVICE  0x00
 
+// A transfer descriptor can only cross one 4kB page boundary
+#define MAX_TD_TRANSFER         4096
+
+// READ(10) and WRITE(10) take a 16-bit number of blocks
+#define MAX_SCSI_BLOCKS         0xFFFF
+
 #define GET_MAX_LUN             (0xFE)
 #define BO_MASS_STORAGE_RESET   (0xFF)
 
@@ -215,20 +221,25 @@ int USBHostMSD::SCSITransfer(uint8_t * cmd, uint8_t cmd_len, int flags, uint8_t
     if (checkResult(res, bulk_out))
         return -1;
 
-    // data stage if needed
+    // data stage if needed, in pieces a single TD can hold
     if (data) {
         USB_DBG("data stage");
-        if (flags == HOST_TO_DEVICE) {
-            
-            res = host->bulkWrite(dev, bulk_out, data, transfer_len);
-            if (checkResult(res, bulk_out))
-                return -1;
+        for (uint32_t done = 0; done < transfer_len; done += MAX_TD_TRANSFER) {
+            uint32_t len = transfer_len - done;
+            if (len > MAX_TD_TRANSFER)
+                len = MAX_TD_TRANSFER;
+            if (flags == HOST_TO_DEVICE) {
+                
+                res = host->bulkWrite(dev, bulk_out, data + done, len);
+                if (checkResult(res, bulk_out))
+                    return -1;
 
-        } else if (flags == DEVICE_TO_HOST) {
+            } else if (flags == DEVICE_TO_HOST) {
 
-            res = host->bulkRead(dev, bulk_in, data, transfer_len);
-            if (checkResult(res, bulk_in))
-                return -1;
+                res = host->bulkRead(dev, bulk_in, data + done, len);
+                if (checkResult(res, bulk_in))
+                    return -1;
+            }
         }
     }
 
@@ -277,7 +288,7 @@ int USBHostMSD::SCSITransfer(uint8_t * cmd, uint8_t cmd_len, int flags, uint8_t
 }
 
 
-int USBHostMSD::dataTransfer(uint8_t * buf, uint32_t block, uint8_t nbBlock, int direction) {
+int USBHostMSD::dataTransfer(uint8_t * buf, uint32_t block, uint16_t nbBlock, int direction) {
     uint8_t cmd[10];
     memset(cmd,0,10);
     cmd[0] = (direction == DEVICE_TO_HOST) ? 0x28 : 0x2A;
@@ -343,6 +354,44 @@ int USBHostMSD::disk_read(uint8_t * buffer, uint64_t block_number) {
     return dataTransfer((uint8_t *)buffer, block_number, 1, DEVICE_TO_HOST);
 }
 
+int USBHostMSD::disk_write(const uint8_t *buffer, uint64_t block_number, uint32_t count) {
+    USB_DBG("FILESYSTEM: write %d blocks from %lld", count, block_number);
+    if (!disk_init) {
+        disk_initialize();
+    }
+    if (!disk_init)
+        return -1;
+    while (count > 0) {
+        uint16_t n = (count > MAX_SCSI_BLOCKS) ? MAX_SCSI_BLOCKS : count;
+        int res = dataTransfer((uint8_t *)buffer, block_number, n, HOST_TO_DEVICE);
+        if (res)
+            return res;
+        buffer += n * blockSize;
+        block_number += n;
+        count -= n;
+    }
+    return 0;
+}
+
+int USBHostMSD::disk_read(uint8_t * buffer, uint64_t block_number, uint32_t count) {
+    USB_DBG("FILESYSTEM: read %d blocks from %lld", count, block_number);
+    if (!disk_init) {
+        disk_initialize();
+    }
+    if (!disk_init)
+        return -1;
+    while (count > 0) {
+        uint16_t n = (count > MAX_SCSI_BLOCKS) ? MAX_SCSI_BLOCKS : count;
+        int res = dataTransfer(buffer, block_number, n, DEVICE_TO_HOST);
+        if (res)
+            return res;
+        buffer += n * blockSize;
+        block_number += n;
+        count -= n;
+    }
+    return 0;
+}
+
 uint64_t USBHostMSD::disk_sectors() {
     USB_DBG("FILESYSTEM: sectors");
     if (!disk_init) {
@@ -61,6 +61,8 @@ protected:
     virtual int disk_status() {return 0;};
     virtual int disk_read(uint8_t * buffer, uint64_t sector);
     virtual int disk_write(const uint8_t * buffer, uint64_t sector);
+    virtual int disk_read(uint8_t * buffer, uint64_t sector, uint32_t count);
+    virtual int disk_write(const uint8_t * buffer, uint64_t sector, uint32_t count);
     virtual int disk_sync() {return 0;};
     virtual uint64_t disk_sectors();
 
@@ -99,7 +101,7 @@ private:
     int readCapacity();
     int inquiry(uint8_t lun, uint8_t page_code);
     int SCSIRequestSense();
-    int dataTransfer(uint8_t * buf, uint32_t block, uint8_t nbBlock, int direction);
+    int dataTransfer(uint8_t * buf, uint32_t block, uint16_t nbBlock, int direction);
     int checkResult(uint8_t res, USBEndpoint * ep);
     int getMaxLun();
 
@@ -0,0 +1,68 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "EmulatedBlockDevice.h"
+#include "wait_api.h"
+#include <string.h>
+
+EmulatedBlockDevice::EmulatedBlockDevice(const char *name) : FATFileSystem(name) {
+    _command_us = 0;
+    _sector_us = 0;
+    reset_stats();
+}
+
+void EmulatedBlockDevice::set_latency(int command_us, int sector_us) {
+    _command_us = command_us;
+    _sector_us = sector_us;
+}
+
+void EmulatedBlockDevice::reset_stats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+void EmulatedBlockDevice::delay(uint32_t count) {
+    int us = _command_us + _sector_us * count;
+    if (us > 0) {
+        wait_us(us);
+    }
+}
+
+int EmulatedBlockDevice::disk_read(uint8_t *buffer, uint64_t sector) {
+    return disk_read(buffer, sector, 1);
+}
+
+int EmulatedBlockDevice::disk_write(const uint8_t *buffer, uint64_t sector) {
+    return disk_write(buffer, sector, 1);
+}
+
+int EmulatedBlockDevice::disk_read(uint8_t *buffer, uint64_t sector, uint32_t count) {
+    if (sector + count > disk_sectors()) {
+        return 1;
+    }
+    _stats.reads++;
+    _stats.sectors_read += count;
+    delay(count);
+    return read_sectors(buffer, sector, count);
+}
+
+int EmulatedBlockDevice::disk_write(const uint8_t *buffer, uint64_t sector, uint32_t count) {
+    if (sector + count > disk_sectors()) {
+        return 1;
+    }
+    _stats.writes++;
+    _stats.sectors_written += count;
+    delay(count);
+    return write_sectors(buffer, sector, count);
+}
@@ -0,0 +1,77 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_EMULATEDBLOCKDEVICE_H
+#define MBED_EMULATEDBLOCKDEVICE_H
+
+#include "FATFileSystem.h"
+#include <stdint.h>
+
+/** Base of the block devices which emulate a disk in memory or in a file,
+ * to run the FAT file system without the hardware
+ *
+ * It counts the commands and sectors transferred, and can add a latency to
+ * every command to behave like an SD card:
+ *
+ * @code
+ * HeapBlockDevice ram("ram", 2048);
+ *
+ * int main() {
+ *     ram.set_latency(400, 40);   // 400us per command, plus 40us per sector
+ *     ram.format();
+ *     FILE *f = fopen("/ram/log.txt", "w");
+ *     ...
+ * }
+ * @endcode
+ */
+class EmulatedBlockDevice : public FATFileSystem {
+public:
+    EmulatedBlockDevice(const char *name);
+
+    /** Wait at every read or write command
+     *
+     *  @param command_us Time taken by each command, in us
+     *  @param sector_us Additional time for each sector transferred, in us
+     */
+    void set_latency(int command_us, int sector_us);
+
+    struct Stats {
+        uint32_t reads;             // read commands
+        uint32_t writes;            // write commands
+        uint32_t sectors_read;
+        uint32_t sectors_written;
+    };
+
+    const Stats &stats() const { return _stats; }
+    void reset_stats();
+
+    virtual int disk_read(uint8_t *buffer, uint64_t sector);
+    virtual int disk_write(const uint8_t *buffer, uint64_t sector);
+    virtual int disk_read(uint8_t *buffer, uint64_t sector, uint32_t count);
+    virtual int disk_write(const uint8_t *buffer, uint64_t sector, uint32_t count);
+
+protected:
+    /* The transfers themselves, with the sectors checked to be on the disk */
+    virtual int read_sectors(uint8_t *buffer, uint64_t sector, uint32_t count) = 0;
+    virtual int write_sectors(const uint8_t *buffer, uint64_t sector, uint32_t count) = 0;
+
+    void delay(uint32_t count);
+
+    int _command_us;
+    int _sector_us;
+    Stats _stats;
+};
+
+#endif
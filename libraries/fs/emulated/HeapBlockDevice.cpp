@@ -0,0 +1,73 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "HeapBlockDevice.h"
+#include <stdlib.h>
+#include <string.h>
+
+HeapBlockDevice::HeapBlockDevice(const char *name, uint32_t sectors) : EmulatedBlockDevice(name) {
+    _count = sectors;
+    _sectors = (uint8_t**)calloc(sectors, sizeof(uint8_t*));
+}
+
+HeapBlockDevice::~HeapBlockDevice() {
+    if (_sectors != NULL) {
+        for (uint32_t i = 0; i < _count; i++) {
+            free(_sectors[i]);
+        }
+        free(_sectors);
+    }
+}
+
+int HeapBlockDevice::disk_initialize() {
+    return (_sectors == NULL) ? 1 : 0;
+}
+
+uint64_t HeapBlockDevice::disk_sectors() {
+    return (_sectors == NULL) ? 0 : _count;
+}
+
+int HeapBlockDevice::read_sectors(uint8_t *buffer, uint64_t sector, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++, buffer += 512) {
+        if (_sectors[sector + i] == NULL) {
+            memset(buffer, 0, 512);
+        } else {
+            memcpy(buffer, _sectors[sector + i], 512);
+        }
+    }
+    return 0;
+}
+
+int HeapBlockDevice::write_sectors(const uint8_t *buffer, uint64_t sector, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++, buffer += 512) {
+        uint8_t *data = _sectors[sector + i];
+        if (data == NULL) {
+            bool zeros = true;
+            for (int j = 0; j < 512 && zeros; j++) {
+                zeros = (buffer[j] == 0);
+            }
+            if (zeros) {
+                continue;
+            }
+            data = (uint8_t*)malloc(512);
+            if (data == NULL) {
+                return 1;
+            }
+            _sectors[sector + i] = data;
+        }
+        memcpy(data, buffer, 512);
+    }
+    return 0;
+}
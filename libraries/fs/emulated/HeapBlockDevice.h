@@ -0,0 +1,48 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_HEAPBLOCKDEVICE_H
+#define MBED_HEAPBLOCKDEVICE_H
+
+#include "EmulatedBlockDevice.h"
+
+/** A disk in RAM
+ *
+ * Sectors are allocated from the heap the first time something other than
+ * zeros is written to them, and read as zeros until then, so a disk can be
+ * larger than the memory as long as little of it is used.
+ */
+class HeapBlockDevice : public EmulatedBlockDevice {
+public:
+    /** Create a RAM disk
+     *
+     *  @param name The name used to access the virtual filesystem
+     *  @param sectors The size of the disk, in 512 byte sectors
+     */
+    HeapBlockDevice(const char *name, uint32_t sectors);
+    virtual ~HeapBlockDevice();
+
+    virtual int disk_initialize();
+    virtual uint64_t disk_sectors();
+
+protected:
+    virtual int read_sectors(uint8_t *buffer, uint64_t sector, uint32_t count);
+    virtual int write_sectors(const uint8_t *buffer, uint64_t sector, uint32_t count);
+
+    uint32_t _count;
+    uint8_t **_sectors;
+};
+
+#endif
@@ -0,0 +1,73 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ImageFileBlockDevice.h"
+#include "mbed_debug.h"
+
+ImageFileBlockDevice::ImageFileBlockDevice(const char *name, const char *path, uint32_t sectors) :
+    EmulatedBlockDevice(name) {
+    _count = 0;
+    _file = fopen(path, "r+b");
+    if (_file == NULL && sectors > 0) {
+        _file = fopen(path, "w+b");
+    }
+    if (_file == NULL) {
+        debug("Could not open disk image %s\n", path);
+        return;
+    }
+    
+    fseek(_file, 0, SEEK_END);
+    long size = ftell(_file);
+    if (sectors > 0 && size < (long)sectors * 512) {
+        // extend the file by writing its last byte
+        fseek(_file, (long)sectors * 512 - 1, SEEK_SET);
+        fputc(0, _file);
+        fflush(_file);
+        size = (long)sectors * 512;
+    }
+    _count = (sectors > 0) ? sectors : size / 512;
+}
+
+ImageFileBlockDevice::~ImageFileBlockDevice() {
+    if (_file != NULL) {
+        fclose(_file);
+    }
+}
+
+int ImageFileBlockDevice::disk_initialize() {
+    return (_file == NULL) ? 1 : 0;
+}
+
+int ImageFileBlockDevice::disk_sync() {
+    return (_file == NULL || fflush(_file)) ? 1 : 0;
+}
+
+uint64_t ImageFileBlockDevice::disk_sectors() {
+    return _count;
+}
+
+int ImageFileBlockDevice::read_sectors(uint8_t *buffer, uint64_t sector, uint32_t count) {
+    if (fseek(_file, (long)sector * 512, SEEK_SET) != 0) {
+        return 1;
+    }
+    return (fread(buffer, 512, count, _file) == count) ? 0 : 1;
+}
+
+int ImageFileBlockDevice::write_sectors(const uint8_t *buffer, uint64_t sector, uint32_t count) {
+    if (fseek(_file, (long)sector * 512, SEEK_SET) != 0) {
+        return 1;
+    }
+    return (fwrite(buffer, 512, count, _file) == count) ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_IMAGEFILEBLOCKDEVICE_H
+#define MBED_IMAGEFILEBLOCKDEVICE_H
+
+#include "EmulatedBlockDevice.h"
+#include <stdio.h>
+
+/** A disk in an image file, such as one made with dd or read from an SD card
+ *
+ * On a PC the image can be checked or mounted with the usual tools, and a
+ * program can run on an image copied from a real card.
+ */
+class ImageFileBlockDevice : public EmulatedBlockDevice {
+public:
+    /** Use an image file as a disk
+     *
+     *  @param name The name used to access the virtual filesystem
+     *  @param path The path of the image file
+     *  @param sectors The size of the disk, in 512 byte sectors; the file is
+     *                 created or extended to it. 0 to use the size of the file
+     */
+    ImageFileBlockDevice(const char *name, const char *path, uint32_t sectors = 0);
+    virtual ~ImageFileBlockDevice();
+
+    virtual int disk_initialize();
+    virtual int disk_sync();
+    virtual uint64_t disk_sectors();
+
+protected:
+    virtual int read_sectors(uint8_t *buffer, uint64_t sector, uint32_t count);
+    virtual int write_sectors(const uint8_t *buffer, uint64_t sector, uint32_t count);
+
+    FILE *_file;
+    uint32_t _count;
+};
+
+#endif
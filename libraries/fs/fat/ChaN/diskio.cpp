@@ -17,6 +17,7 @@ DSTATUS disk_initialize (
 ) 
 {
     debug_if(FFS_DBG, "disk_initialize on drv [%d]\n", drv);
+    FATFileSystem::_ffs[drv]->_cache.invalidate();
     return (DSTATUS)FATFileSystem::_ffs[drv]->disk_initialize();
 }
 
@@ -36,13 +37,9 @@ DRESULT disk_read (
 )
 {
     debug_if(FFS_DBG, "disk_read(sector %d, count %d) on drv [%d]\n", sector, count, drv);
-    for(DWORD s=sector; s<sector+count; s++) {
-        debug_if(FFS_DBG, " disk_read(sector %d)\n", s);
-        int res = FATFileSystem::_ffs[drv]->disk_read((uint8_t*)buff, s);
-        if(res) {
-            return RES_PARERR;
-        }
-        buff += 512;
+    int res = FATFileSystem::_ffs[drv]->_cache.read((uint8_t*)buff, sector, count);
+    if(res) {
+        return RES_PARERR;
     }
     return RES_OK;
 }
@@ -56,13 +53,9 @@ DRESULT disk_write (
 )
 {
     debug_if(FFS_DBG, "disk_write(sector %d, count %d) on drv [%d]\n", sector, count, drv);
-    for(DWORD s = sector; s < sector + count; s++) {
-        debug_if(FFS_DBG, " disk_write(sector %d)\n", s);
-        int res = FATFileSystem::_ffs[drv]->disk_write((uint8_t*)buff, s);
-        if(res) {
-            return RES_PARERR;
-        }
-        buff += 512;
+    int res = FATFileSystem::_ffs[drv]->_cache.write((const uint8_t*)buff, sector, count);
+    if(res) {
+        return RES_PARERR;
     }
     return RES_OK;
 }
@@ -79,7 +72,8 @@ DRESULT disk_ioctl (
         case CTRL_SYNC:
             if(FATFileSystem::_ffs[drv] == NULL) {
                 return RES_NOTRDY;
-            } else if(FATFileSystem::_ffs[drv]->disk_sync()) {
+            } else if(FATFileSystem::_ffs[drv]->_cache.flush() ||
+                      FATFileSystem::_ffs[drv]->disk_sync()) {
                 return RES_ERROR;
             }
             return RES_OK;
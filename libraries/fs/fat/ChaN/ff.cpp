@@ -502,7 +502,7 @@ static WCHAR LfnBuf[_MAX_LFN+1];
 
 #elif _USE_LFN == 3         /* LFN feature with dynamic working buffer on the heap */
 #define DEF_NAMEBUF         BYTE sfn[12]; WCHAR *lfn
-#define INIT_BUF(dobj)      { lfn = ff_memalloc((_MAX_LFN + 1) * 2); \
+#define INIT_BUF(dobj)      { lfn = (WCHAR*)ff_memalloc((_MAX_LFN + 1) * 2); \
                               if (!lfn) LEAVE_FF((dobj).fs, FR_NOT_ENOUGH_CORE); \
                               (dobj).lfn = lfn; (dobj).fn = sfn; }
 #define FREE_BUF()          ff_memfree(lfn)
@@ -1381,13 +1381,164 @@ BYTE sum_sfn (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Directory handling - Lookup cache                                     */
+/*-----------------------------------------------------------------------*/
+/* The cache maps a directory and the hash of a name to the location of the
+/  entry found for it. A cached location is checked against the directory
+/  before it is used, so a stale slot costs a scan but never a wrong match. */
+#if _USE_DIRCACHE
+static
+DWORD dc_hash (     /* Hash of the name looked up: its LFN in upper case, or its SFN */
+    FATFS_DIR *dj
+)
+{
+    DWORD h = 2166136261UL;     /* FNV-1a */
+    UINT i;
+
+#if _USE_LFN
+    if (dj->lfn) {
+        for (i = 0; dj->lfn[i]; i++)
+            h = (h ^ ff_wtoupper(dj->lfn[i])) * 16777619UL;
+        return h;
+    }
+#endif
+    for (i = 0; i < 11; i++)
+        h = (h ^ dj->fn[i]) * 16777619UL;
+    return h;
+}
+
+
+#if _FS_MINIMIZE <= 1
+static
+DWORD dc_hash_entry (   /* Hash of the entry read by dir_read(), as dc_hash() of a lookup of its name */
+    FATFS_DIR *dj
+)
+{
+    DWORD h = 2166136261UL;
+    UINT i;
+#if _USE_LFN
+    WCHAR c;
+
+    if (dj->lfn_idx != 0xFFFF)      /* The LFN picked by dir_read() */
+        return dc_hash(dj);
+    for (i = 0; i < 11; i++) {      /* The SFN, as "NAME.EXT" */
+        c = dj->dir[i];
+        if (c == ' ') {
+            if (i >= 8) break;
+            i = 7;
+            continue;
+        }
+        if (i == 8) h = (h ^ '.') * 16777619UL;
+        if (c == NDDE) c = DDE;
+        if (c >= 0x80) c = ff_convert(c, 1);
+        h = (h ^ ff_wtoupper(c)) * 16777619UL;
+    }
+#else
+    for (i = 0; i < 11; i++)
+        h = (h ^ dj->dir[i]) * 16777619UL;
+#endif
+    return h;
+}
+#endif
+
+
+static
+DIRCACHE* dc_set (  /* The two slots a name can be cached in, the last used first */
+    FATFS_DIR *dj,
+    DWORD hash
+)
+{
+    return &dj->fs->dcache[(hash ^ dj->sclust * 2654435761UL) % (dj->fs->dcsize / 2) * 2];
+}
+
+
+static
+void dc_store (     /* Record the location of the entry the directory object points to */
+    FATFS_DIR *dj,
+    DWORD hash
+)
+{
+    DIRCACHE *dc;
+
+    dc = dc_set(dj, hash);
+    if (dc[0].sclust != dj->sclust || dc[0].hash != hash)
+        dc[1] = dc[0];      /* Evict the least recently used */
+    dc[0].sclust = dj->sclust;
+    dc[0].hash = hash;
+    dc[0].clust = dj->clust;
+    dc[0].index = dj->index;
+#if _USE_LFN
+    dc[0].lfn_idx = dj->lfn_idx;
+#else
+    dc[0].lfn_idx = 0xFFFF;
+#endif
+}
+
+
+static
+FRESULT dc_seek (   /* Move to the first entry of a cached location */
+    FATFS_DIR *dj,
+    const DIRCACHE *dc
+)
+{
+    WORD idx, ic;
+
+
+    idx = (dc->lfn_idx != 0xFFFF) ? dc->lfn_idx : dc->index;
+    ic = SS(dj->fs) / SZ_DIR * dj->fs->csize;   /* Entries per cluster */
+    if (dc->clust < 2 || dc->clust >= dj->fs->n_fatent || idx / ic != dc->index / ic)
+        return dir_sdi(dj, idx);    /* Static table, or an LFN starting in the previous cluster */
+
+    dj->index = idx;
+    dj->clust = dc->clust;
+    dj->sect = clust2sect(dj->fs, dc->clust) + (idx % ic) / (SS(dj->fs) / SZ_DIR);
+    dj->dir = dj->fs->win + (idx % (SS(dj->fs) / SZ_DIR)) * SZ_DIR;
+    return FR_OK;
+}
+
+
+static
+void dc_drop (      /* Forget the entry at index in a directory, or all its entries (index 0xFFFFFFFF) */
+    FATFS *fs,
+    DWORD sclust,
+    DWORD index
+)
+{
+    UINT i;
+
+    if (!fs->dcache) return;
+    for (i = 0; i < fs->dcsize; i++) {
+        if (fs->dcache[i].sclust == sclust && (index == 0xFFFFFFFF || fs->dcache[i].index == index))
+            fs->dcache[i].sclust = 0xFFFFFFFF;
+    }
+}
+
+
+static
+void dc_clear (
+    FATFS *fs
+)
+{
+    UINT i;
+
+    if (!fs->dcache) return;
+    for (i = 0; i < fs->dcsize; i++)
+        fs->dcache[i].sclust = 0xFFFFFFFF;
+}
+#endif
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Directory handling - Find an object in the directory                  */
 /*-----------------------------------------------------------------------*/
 
 static
-FRESULT dir_find (
-    FATFS_DIR *dj         /* Pointer to the directory object linked to the file name */
+FRESULT dir_scan (  /* FR_OK:Found, FR_NO_FILE:Not found up to the last index */
+    FATFS_DIR *dj,        /* Pointer to the directory object linked to the file name, at the first entry to look at */
+    WORD last       /* Last index to look at */
 )
 {
     FRESULT res;
@@ -1396,9 +1547,6 @@ FRESULT dir_find (
     BYTE a, ord, sum;
 #endif
 
-    res = dir_sdi(dj, 0);           /* Rewind directory object */
-    if (res != FR_OK) return res;
-
 #if _USE_LFN
     ord = sum = 0xFF;
 #endif
@@ -1433,6 +1581,7 @@ FRESULT dir_find (
         if (!(dir[DIR_Attr] & AM_VOL) && !mem_cmp(dir, dj->fn, 11)) /* Is it a valid entry? */
             break;
 #endif
+        if (dj->index == last) { res = FR_NO_FILE; break; }
         res = dir_next(dj, 0);      /* Next entry */
     } while (res == FR_OK);
 
@@ -1440,6 +1589,43 @@ FRESULT dir_find (
 }
 
 
+static
+FRESULT dir_find (
+    FATFS_DIR *dj         /* Pointer to the directory object linked to the file name */
+)
+{
+    FRESULT res;
+#if _USE_DIRCACHE
+    DIRCACHE *dc;
+    DWORD hash = 0;
+
+    if (dj->fs->dcache) {
+        hash = dc_hash(dj);
+        dc = dc_set(dj, hash);
+        if (dc[1].sclust == dj->sclust && dc[1].hash == hash) {
+            DIRCACHE t = dc[0]; dc[0] = dc[1]; dc[1] = t;
+        }
+        if (dc->sclust == dj->sclust && dc->hash == hash) {
+            /* Match the entries of the cached location only */
+            res = dc_seek(dj, dc);
+            if (res == FR_OK) res = dir_scan(dj, dc->index);
+            if (res == FR_OK && dj->index == dc->index) return FR_OK;
+            if (res != FR_OK && res != FR_NO_FILE) return res;
+        }
+    }
+#endif
+
+    res = dir_sdi(dj, 0);           /* Rewind directory object */
+    if (res != FR_OK) return res;
+    res = dir_scan(dj, 0xFFFF);
+#if _USE_DIRCACHE
+    if (res == FR_OK && dj->fs->dcache) dc_store(dj, hash);
+#endif
+
+    return res;
+}
+
+
 
 
 /*-----------------------------------------------------------------------*/
@@ -1557,6 +1743,7 @@ FRESULT dir_register (  /* FR_OK:Successful, FR_DENIED:No free entry or too many
         }
         res = dir_next(dj, 1);      /* Next entry with table stretch */
     } while (res == FR_OK);
+    dj->lfn_idx = (ne > 1) ? is : 0xFFFF;
 
     if (res == FR_OK && ne > 1) {   /* Initialize LFN entry if needed */
         res = dir_sdi(dj, is);
@@ -1596,6 +1783,9 @@ FRESULT dir_register (  /* FR_OK:Successful, FR_DENIED:No free entry or too many
             dir[DIR_NTres] = *(dj->fn+NS) & (NS_BODY | NS_EXT); /* Put NT flag */
 #endif
             dj->fs->wflag = 1;
+#if _USE_DIRCACHE
+            if (dj->fs->dcache) dc_store(dj, dc_hash(dj));
+#endif
         }
     }
 
@@ -1619,6 +1809,9 @@ FRESULT dir_remove (    /* FR_OK: Successful, FR_DISK_ERR: A disk error */
 #if _USE_LFN    /* LFN configuration */
     WORD i;
 
+#if _USE_DIRCACHE
+    dc_drop(dj->fs, dj->sclust, dj->index);
+#endif
     i = dj->index;  /* SFN index */
     res = dir_sdi(dj, (WORD)((dj->lfn_idx == 0xFFFF) ? i : dj->lfn_idx));   /* Goto the SFN or top of the LFN entries */
     if (res == FR_OK) {
@@ -1634,6 +1827,9 @@ FRESULT dir_remove (    /* FR_OK: Successful, FR_DISK_ERR: A disk error */
     }
 
 #else           /* Non LFN configuration */
+#if _USE_DIRCACHE
+    dc_drop(dj->fs, dj->sclust, dj->index);
+#endif
     res = dir_sdi(dj, dj->index);
     if (res == FR_OK) {
         res = move_window(dj->fs, dj->sect);
@@ -2187,6 +2383,9 @@ FRESULT chk_mounted (   /* FR_OK(0): successful, !=0: any error occurred */
 #endif
     fs->fs_type = fmt;      /* FAT sub-type */
     fs->id = ++Fsid;        /* File system mount ID */
+#if _USE_DIRCACHE
+    dc_clear(fs);           /* The cached locations may be of another volume */
+#endif
     fs->winsect = 0;        /* Invalidate sector cache */
     fs->wflag = 0;
 #if _FS_RPATH
@@ -3076,6 +3275,10 @@ FRESULT f_readdir (
                 res = FR_OK;
             }
             if (res == FR_OK) {             /* A valid entry is found */
+#if _USE_DIRCACHE
+                if (dj->sect && dj->fs->dcache)     /* Look-ups of the names listed are likely */
+                    dc_store(dj, dc_hash_entry(dj));
+#endif
                 get_fileinfo(dj, fno);      /* Get the object information */
                 res = dir_next(dj, 0);      /* Increment index for next */
                 if (res == FR_NO_FILE) {
@@ -3217,7 +3420,7 @@ FRESULT f_truncate (
         }
     }
     if (res == FR_OK) {
-        if (fp->fsize > fp->fptr) {
+        if (fp->fsize > fp->fptr || (fp->fsize == fp->fptr && fp->sclust)) {  /* Also frees the clusters f_expand() allocated past the end */
             fp->fsize = fp->fptr;   /* Set file size to current R/W point */
             fp->flag |= FA__WRITTEN;
             if (fp->fptr == 0) {    /* When set file size to zero, remove entire cluster chain */
@@ -3243,6 +3446,72 @@ FRESULT f_truncate (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Allocate a Contiguous Cluster Chain to an Empty File                  */
+/*-----------------------------------------------------------------------*/
+
+FRESULT f_expand (
+    FIL *fp,    /* Pointer to the file object */
+    DWORD fsz   /* Number of bytes to allocate */
+)
+{
+    FRESULT res;
+    FATFS *fs;
+    DWORD n, clst, stcl, scl, ncl, v;
+
+
+    if (!fp) return FR_INVALID_OBJECT;
+
+    res = validate(fp);                     /* Check validity of the object */
+    if (res != FR_OK) LEAVE_FF(fp->fs, res);
+    if (fp->flag & FA__ERROR)               /* Check abort flag */
+        LEAVE_FF(fp->fs, FR_INT_ERR);
+    if (!(fp->flag & FA_WRITE) || fp->sclust || fsz == 0)  /* Only to an empty file open for writing */
+        LEAVE_FF(fp->fs, FR_DENIED);
+
+    fs = fp->fs;
+    n = (fsz + (DWORD)fs->csize * SS(fs) - 1) / ((DWORD)fs->csize * SS(fs));   /* Number of clusters */
+    stcl = fs->last_clust;                  /* Scan from the suggested start point */
+    if (stcl < 2 || stcl >= fs->n_fatent) stcl = 2;
+
+    clst = scl = stcl; ncl = 0;
+    for (;;) {                              /* Find a run of n free clusters */
+        v = get_fat(fs, clst);
+        if (v == 1) LEAVE_FF(fs, FR_INT_ERR);
+        if (v == 0xFFFFFFFF) LEAVE_FF(fs, FR_DISK_ERR);
+        if (v == 0) {
+            if (++ncl == n) break;
+        } else {
+            ncl = 0;
+        }
+        if (++clst >= fs->n_fatent) {       /* A run cannot wrap around */
+            clst = 2; ncl = 0;
+        }
+        if (ncl == 0) scl = clst;
+        if (clst == stcl) LEAVE_FF(fs, FR_DENIED);  /* No run long enough */
+    }
+
+    for (clst = scl; clst < scl + n && res == FR_OK; clst++)   /* Link the run */
+        res = put_fat(fs, clst, (clst == scl + n - 1) ? 0x0FFFFFFF : clst + 1);
+    if (res == FR_OK) {
+        fs->last_clust = scl + n - 1;       /* Update FSINFO */
+        if (fs->free_clust != 0xFFFFFFFF) {
+            fs->free_clust -= n;
+            fs->fsi_flag = 1;
+        }
+        fp->sclust = scl;                   /* The file size is left as it is */
+        fp->clust = scl;
+        fp->flag |= FA__WRITTEN;
+    } else {
+        fp->flag |= FA__ERROR;
+    }
+
+    LEAVE_FF(fs, res);
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Delete a File or Directory                                            */
 /*-----------------------------------------------------------------------*/
@@ -3297,6 +3566,10 @@ FRESULT f_unlink (
             if (res == FR_OK) {
                 res = dir_remove(&dj);      /* Remove the directory entry */
                 if (res == FR_OK) {
+#if _USE_DIRCACHE
+                    if (dclst)              /* Forget the entries of a removed directory */
+                        dc_drop(dj.fs, dclst, 0xFFFFFFFF);
+#endif
                     if (dclst)              /* Remove the cluster chain if exist */
                         res = remove_chain(dj.fs, dclst);
                     if (res == FR_OK) res = sync(dj.fs);
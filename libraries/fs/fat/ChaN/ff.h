@@ -72,6 +72,20 @@ typedef char TCHAR;
 
 
 
+/* Directory lookup cache entry (DIRCACHE) */
+
+#if _USE_DIRCACHE
+typedef struct {
+    DWORD   sclust;         /* Start cluster of the directory (0xFFFFFFFF:Empty slot) */
+    DWORD   hash;           /* Hash of the name looked up */
+    DWORD   clust;          /* Cluster containing the SFN entry (0:Static table) */
+    WORD    index;          /* Index of the SFN entry */
+    WORD    lfn_idx;        /* Index of the first LFN entry (0xFFFF:No LFN) */
+} DIRCACHE;
+#endif
+
+
+
 /* File system object structure (FATFS) */
 
 typedef struct {
@@ -96,6 +110,10 @@ typedef struct {
 #endif
 #if _FS_RPATH
     DWORD   cdir;           /* Current directory start cluster (0:root) */
+#endif
+#if _USE_DIRCACHE
+    DIRCACHE* dcache;       /* Directory lookup cache table (null:Not used) */
+    UINT    dcsize;         /* Number of entries in the table (even) */
 #endif
     DWORD   n_fatent;       /* Number of FAT entries (= number of clusters + 2) */
     DWORD   fsize;          /* Sectors per FAT */
@@ -213,6 +231,7 @@ FRESULT f_stat (const TCHAR*, FILINFO*);            /* Get file status */
 FRESULT f_write (FIL*, const void*, UINT, UINT*);   /* Write data to a file */
 FRESULT f_getfree (const TCHAR*, DWORD*, FATFS**);  /* Get number of free clusters on the drive */
 FRESULT f_truncate (FIL*);                          /* Truncate file */
+FRESULT f_expand (FIL*, DWORD);                     /* Allocate a contiguous cluster chain to an empty file */
 FRESULT f_sync (FIL*);                              /* Flush cached data of a writing file */
 FRESULT f_unlink (const TCHAR*);                    /* Delete an existing file or directory */
 FRESULT f_mkdir (const TCHAR*);                     /* Create a new directory */
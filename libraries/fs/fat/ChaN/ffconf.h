@@ -49,10 +49,15 @@
 /* To enable f_forward function, set _USE_FORWARD to 1 and set _FS_TINY to 1. */
 
 
-#define _USE_FASTSEEK   0   /* 0:Disable or 1:Enable */
+#define _USE_FASTSEEK   1   /* 0:Disable or 1:Enable */
 /* To enable fast seek feature, set _USE_FASTSEEK to 1. */
 
 
+#define _USE_DIRCACHE   1   /* 0:Disable or 1:Enable */
+/* To enable the directory lookup cache, set _USE_DIRCACHE to 1. The cache is
+/  used when the application gives it a table (see FATFS.dcache). */
+
+
 
 /*---------------------------------------------------------------------------/
 / Locale and Namespace Configurations
@@ -91,7 +96,7 @@
 */
 
 
-#define _USE_LFN    1       /* 0 to 3 */
+#define _USE_LFN    3       /* 0 to 3 */
 #define _MAX_LFN    255     /* Maximum LFN length to handle (12 to 255) */
 /* The _USE_LFN option switches the LFN support.
 /
@@ -126,7 +131,7 @@
 / Physical Drive Configurations
 /----------------------------------------------------------------------------*/
 
-#define _VOLUMES    1
+#define _VOLUMES    4
 /* Number of volumes (logical drives) to be used. */
 
 
@@ -171,9 +176,11 @@
 /* A header file that defines sync object types on the O/S, such as
 /  windows.h, ucos_ii.h and semphr.h, must be included prior to ff.h. */
 
-#define _FS_REENTRANT   0       /* 0:Disable or 1:Enable */
+#define _FS_REENTRANT   1       /* 0:Disable or 1:Enable */
 #define _FS_TIMEOUT     1000    /* Timeout period in unit of time ticks */
-#define _SYNC_t         HANDLE  /* O/S dependent type of sync object. e.g. HANDLE, OS_EVENT*, ID and etc.. */
+#define _SYNC_t         void*   /* O/S dependent type of sync object. e.g. HANDLE, OS_EVENT*, ID and etc.. */
+/* mbed: the sync object of a volume is the PlatformMutex of its FATFileSystem
+/  (see FATFileSystem.cpp), which waits without a timeout. */
 
 /* The _FS_REENTRANT option switches the reentrancy (thread safe) of the FatFs module.
 /
@@ -25,8 +25,9 @@
 
 using namespace mbed;
 
-FATDirHandle::FATDirHandle(const FATFS_DIR &the_dir) {
+FATDirHandle::FATDirHandle(const FATFS_DIR &the_dir, PlatformMutex *mutex) {
     dir = the_dir;
+    _mutex = mutex;
 }
 
 int FATDirHandle::closedir() {
@@ -35,33 +36,39 @@ int FATDirHandle::closedir() {
 }
 
 struct dirent *FATDirHandle::readdir() {
+    return readdir(&cur_entry) == 1 ? &cur_entry : NULL;
+}
+
+int FATDirHandle::readdir(struct dirent *entry, FILINFO *info) {
     FILINFO finfo;
+    if (info == NULL) {
+        info = &finfo;
+    }
 
 #if _USE_LFN
-    finfo.lfname = cur_entry.d_name;
-    finfo.lfsize = sizeof(cur_entry.d_name);
+    info->lfname = entry->d_name;
+    info->lfsize = sizeof(entry->d_name);
 #endif // _USE_LFN
 
-    FRESULT res = f_readdir(&dir, &finfo);
+    if (_mutex != NULL) _mutex->lock();
+    FRESULT res = f_readdir(&dir, info);
+    if (_mutex != NULL) _mutex->unlock();
 
+    if (res != 0) {
+        return -1;
+    }
+    if (info->fname[0] == 0) {
+        return 0;
+    }
 #if _USE_LFN
-    if(res != 0 || finfo.fname[0]==0) {
-        return NULL;
-    } else {
-        if(cur_entry.d_name[0]==0) {
-            // No long filename so use short filename.
-            memcpy(cur_entry.d_name, finfo.fname, sizeof(finfo.fname));
-        }
-        return &cur_entry;
+    if (entry->d_name[0] == 0) {
+        // No long filename so use short filename.
+        memcpy(entry->d_name, info->fname, sizeof(info->fname));
     }
 #else
-    if(res != 0 || finfo.fname[0]==0) {
-        return NULL;
-    } else {
-        memcpy(cur_entry.d_name, finfo.fname, sizeof(finfo.fname));
-        return &cur_entry;
-    }
+    memcpy(entry->d_name, info->fname, sizeof(info->fname));
 #endif /* _USE_LFN */
+    return 1;
 }
 
 void FATDirHandle::rewinddir() {
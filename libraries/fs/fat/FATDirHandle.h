@@ -23,15 +23,33 @@
 #define MBED_FATDIRHANDLE_H
 
 #include "DirHandle.h"
+#include "ff.h"
+#include "PlatformMutex.h"
 
 using namespace mbed;
 
 class FATDirHandle : public DirHandle {
 
  public:
-    FATDirHandle(const FATFS_DIR &the_dir);
+    FATDirHandle(const FATFS_DIR &the_dir, PlatformMutex *mutex = NULL);
     virtual int closedir();
     virtual struct dirent *readdir();
+
+    /** Read the next entry into buffers of the caller
+     *
+     *  The name is stored straight into entry, without going through the
+     *  handle, and the size, date and attributes into info if given, which
+     *  saves a stat() of each entry when listing a directory.
+     *
+     *  @param entry The buffer for the name of the entry
+     *  @param info The buffer for the status of the entry, or NULL
+     *
+     *  @returns
+     *    1 if an entry was read,
+     *    0 at the end of the directory,
+     *   -1 on error
+     */
+    int readdir(struct dirent *entry, FILINFO *info = NULL);
     virtual void rewinddir();
     virtual off_t telldir();
     virtual void seekdir(off_t location);
@@ -39,6 +57,7 @@ class FATDirHandle : public DirHandle {
  private:
     FATFS_DIR dir;
     struct dirent cur_entry;
+    PlatformMutex *_mutex;
 
 };
 
@@ -21,34 +21,127 @@
  */
 #include "ff.h"
 #include "ffconf.h"
+#include "diskio.h"
 #include "mbed_debug.h"
+#include <string.h>
 
 #include "FATFileHandle.h"
 
-FATFileHandle::FATFileHandle(FIL fh) {
+FATFileHandle::FATFileHandle(FIL fh, PlatformMutex *mutex) {
     _fh = fh;
+    _mutex = mutex;
+    _map = NULL;
+    _map_stale = false;
+    _reserved = 0;
+}
+
+void FATFileHandle::lock() {
+    if (_mutex != NULL) {
+        _mutex->lock();
+    }
+}
+
+void FATFileHandle::unlock() {
+    if (_mutex != NULL) {
+        _mutex->unlock();
+    }
 }
 
 int FATFileHandle::close() {
+    lock();
+    if (_reserved > _fh.fsize) {
+        // free the clusters reserved past the end
+        _fh.cltbl = NULL;
+        if (f_lseek(&_fh, _fh.fsize) == FR_OK) {
+            f_truncate(&_fh);
+        }
+    }
     int retval = f_close(&_fh);
+    unlock();
+    delete[] _map;
     delete this;
     return retval;
 }
 
 ssize_t FATFileHandle::write(const void* buffer, size_t length) {
     UINT n;
-    FRESULT res = f_write(&_fh, buffer, length, &n);
+    lock();
+    if (_fh.cltbl != NULL && _fh.fptr + length > _fh.fsize
+                          && _fh.fptr + length > _reserved) {
+        // the map cannot follow the chain as it grows
+        _fh.cltbl = NULL;
+        _map_stale = true;
+    }
+    ssize_t direct = append_sectors((const uint8_t*)buffer, length);
+    if (direct < 0) {
+        unlock();
+        return -1;
+    }
+    FRESULT res = FR_OK;
+    n = 0;
+    if ((size_t)direct < length) {
+        res = f_write(&_fh, (const uint8_t*)buffer + direct, length - direct, &n);
+    }
+    unlock();
     if (res) { 
         debug_if(FFS_DBG, "f_write() failed: %d", res);
         return -1;
     }
-    return n;
+    return direct + n;
+}
+
+/* Called locked: append the whole sectors at the start of buffer to a file
+ * with reserved clusters, which are contiguous, so the sectors can be
+ * written to the disk without following the chain. Returns the number of
+ * bytes written, which may be 0, or -1 on error. */
+ssize_t FATFileHandle::append_sectors(const uint8_t *buffer, size_t length) {
+    if (_fh.fptr != _fh.fsize || _fh.fptr % 512 != 0 || _fh.fptr >= _reserved) {
+        return 0;
+    }
+    DWORD count = length / 512;
+    if (count > (_reserved - _fh.fptr) / 512) {
+        count = (_reserved - _fh.fptr) / 512;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    
+    // the buffered sector goes first
+    if (_fh.flag & FA__DIRTY) {
+        if (disk_write(_fh.fs->drv, _fh.buf, _fh.dsect, 1) != RES_OK) {
+            return -1;
+        }
+        _fh.flag &= ~FA__DIRTY;
+    }
+    
+    DWORD cluster_size = (DWORD)_fh.fs->csize * 512;
+    DWORD sector = _fh.fs->database + (_fh.sclust - 2) * _fh.fs->csize + _fh.fptr / 512;
+    for (DWORD done = 0; done < count; ) {
+        BYTE n = (count - done > 255) ? 255 : count - done;
+        if (disk_write(_fh.fs->drv, buffer + done * 512, sector + done, n) != RES_OK) {
+            debug_if(FFS_DBG, "disk_write() of %d reserved sectors failed\n", n);
+            return -1;
+        }
+        if (_fh.dsect - (sector + done) < n) {
+            // keep the buffered sector up to date
+            memcpy(_fh.buf, buffer + (_fh.dsect - sector) * 512, 512);
+        }
+        done += n;
+    }
+    
+    _fh.fptr += count * 512;
+    _fh.fsize = _fh.fptr;
+    _fh.clust = _fh.sclust + (_fh.fptr - 1) / cluster_size;
+    _fh.flag |= FA__WRITTEN;
+    return count * 512;
 }
         
 ssize_t FATFileHandle::read(void* buffer, size_t length) {
     debug_if(FFS_DBG, "read(%d)\n", length);
     UINT n;
+    lock();
     FRESULT res = f_read(&_fh, buffer, length, &n);
+    unlock();
     if (res) {
         debug_if(FFS_DBG, "f_read() failed: %d\n", res);
         return -1;
@@ -61,12 +154,28 @@ int FATFileHandle::isatty() {
 }
 
 off_t FATFileHandle::lseek(off_t position, int whence) {
+    lock();
     if (whence == SEEK_END) {
         position += _fh.fsize;
     } else if(whence==SEEK_CUR) {
         position += _fh.fptr;
     }
-    FRESULT res = f_lseek(&_fh, position);
+    if (position < 0) {
+        unlock();
+        debug_if(FFS_DBG, "lseek failed: negative position\n");
+        return -1;
+    }
+    if (_map != NULL && (DWORD)position <= _fh.fsize) {
+        if (_map_stale) {
+            build_map();
+        }
+    } else if (_fh.cltbl != NULL) {
+        // growing the file by seeking past its end
+        _fh.cltbl = NULL;
+        _map_stale = true;
+    }
+    FRESULT res = f_lseek(&_fh, (DWORD)position);
+    unlock();
     if (res) {
         debug_if(FFS_DBG, "lseek failed: %d\n", res);
         return -1;
@@ -77,7 +186,9 @@ off_t FATFileHandle::lseek(off_t position, int whence) {
 }
 
 int FATFileHandle::fsync() {
+    lock();
     FRESULT res = f_sync(&_fh);
+    unlock();
     if (res) {
         debug_if(FFS_DBG, "f_sync() failed: %d\n", res);
         return -1;
@@ -88,3 +199,87 @@ int FATFileHandle::fsync() {
 off_t FATFileHandle::flen() {
     return _fh.fsize;
 }
+
+int FATFileHandle::enable_fast_seek(size_t map_entries) {
+    lock();
+    disable_fast_seek();
+    if (map_entries == 0) {
+        // let FatFs count the entries the file needs
+        DWORD probe[2] = {2, 0};
+        _fh.cltbl = probe;
+        FRESULT res = f_lseek(&_fh, CREATE_LINKMAP);
+        _fh.cltbl = NULL;
+        if (res != FR_OK && res != FR_NOT_ENOUGH_CORE) {
+            unlock();
+            return -1;
+        }
+        map_entries = probe[0];
+    }
+    _map = new DWORD[map_entries];
+    _map[0] = map_entries;
+    int result = build_map();
+    if (result != 0) {
+        disable_fast_seek();
+    }
+    unlock();
+    return result;
+}
+
+void FATFileHandle::disable_fast_seek() {
+    lock();
+    _fh.cltbl = NULL;
+    delete[] _map;
+    _map = NULL;
+    _map_stale = false;
+    unlock();
+}
+
+int FATFileHandle::reserve(size_t size) {
+    lock();
+    FRESULT res = f_expand(&_fh, size);
+    if (res == FR_OK) {
+        res = f_sync(&_fh);
+    }
+    if (res == FR_OK) {
+        DWORD cluster_size = (DWORD)_fh.fs->csize * 512;
+        _reserved = (size + cluster_size - 1) / cluster_size * cluster_size;
+        _fh.cltbl = NULL;
+        _map_stale = true;
+    }
+    unlock();
+    if (res) {
+        debug_if(FFS_DBG, "f_expand() failed: %d\n", res);
+        return -1;
+    }
+    return 0;
+}
+
+/* Called locked, with _map[0] the size of the map; grows the map if the
+ * file needs more entries than it had when the map was allocated */
+int FATFileHandle::build_map() {
+    DWORD size = _map[0];
+    _fh.cltbl = _map;
+    FRESULT res = f_lseek(&_fh, CREATE_LINKMAP);
+    if (res == FR_NOT_ENOUGH_CORE && _map_stale) {
+        size = _map[0];
+        delete[] _map;
+        _map = new DWORD[size];
+        _map[0] = size;
+        _fh.cltbl = _map;
+        res = f_lseek(&_fh, CREATE_LINKMAP);
+    }
+    _map_stale = false;
+    if (res == FR_NOT_ENOUGH_CORE) {
+        int needed = _map[0];
+        _map[0] = size;
+        _fh.cltbl = NULL;
+        return needed;
+    }
+    if (res != FR_OK) {
+        debug_if(FFS_DBG, "f_lseek(CREATE_LINKMAP) failed: %d\n", res);
+        _fh.cltbl = NULL;
+        return -1;
+    }
+    _map[0] = size;
+    return 0;
+}
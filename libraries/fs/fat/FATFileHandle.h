@@ -23,13 +23,19 @@
 #define MBED_FATFILEHANDLE_H
 
 #include "FileHandle.h"
+#include "PlatformMutex.h"
 
 using namespace mbed;
 
 class FATFileHandle : public FileHandle {
 public:
 
-    FATFileHandle(FIL fh);
+    /** Wrap an open FatFs file
+     *
+     *  @param fh The FatFs file
+     *  @param mutex The lock of its volume, or NULL
+     */
+    FATFileHandle(FIL fh, PlatformMutex *mutex = NULL);
     virtual int close();
     virtual ssize_t write(const void* buffer, size_t length);
     virtual ssize_t read(void* buffer, size_t length);
@@ -38,9 +44,53 @@ public:
     virtual int fsync();
     virtual off_t flen();
 
+    /** Seek through a map of the clusters of the file instead of following
+     *  its FAT chain, which takes time in proportion to the offset
+     *
+     *  The map holds two entries for each contiguous run of clusters, plus
+     *  two. It is rebuilt when the file has grown, at the next seek.
+     *
+     *  @param map_entries Size of the map, or 0 for the size the file needs
+     *
+     *  @returns
+     *    0 on success,
+     *    the number of entries needed if map_entries is too small,
+     *    -1 on error
+     */
+    int enable_fast_seek(size_t map_entries = 0);
+
+    /** Follow the FAT chain again, and free the map
+     */
+    void disable_fast_seek();
+
+    /** Allocate contiguous clusters for size bytes to an empty file
+     *
+     *  The clusters are linked in the FAT at once, so appending to the
+     *  file does not allocate any. Whole sectors appended at a sector
+     *  boundary are written straight to the disk, without going through
+     *  FatFs; the size in the directory entry is updated by fsync().
+     *  The clusters left unused are freed by close().
+     *
+     *  @param size Number of bytes to reserve
+     *
+     *  @returns
+     *    0 on success,
+     *    -1 if the file is not empty or there is no contiguous free space
+     */
+    int reserve(size_t size);
+
 protected:
 
+    void lock();
+    void unlock();
+    int build_map();
+    ssize_t append_sectors(const uint8_t *buffer, size_t length);
+
     FIL _fh;
+    PlatformMutex *_mutex;
+    DWORD *_map;        // cluster link map, or NULL
+    bool _map_stale;    // the file grew since the map was built
+    DWORD _reserved;    // bytes in the clusters reserve() allocated
 
 };
 
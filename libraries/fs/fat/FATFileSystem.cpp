@@ -28,22 +28,73 @@
 #include "FATFileHandle.h"
 #include "FATDirHandle.h"
 
+// localtime() returns a static buffer, and the volumes can call this at once
+static PlatformMutex fattime_mutex;
+
 DWORD get_fattime(void) {
     time_t rawtime;
     time(&rawtime);
-    struct tm *ptm = localtime(&rawtime);
-    return (DWORD)(ptm->tm_year - 80) << 25
-         | (DWORD)(ptm->tm_mon + 1  ) << 21
-         | (DWORD)(ptm->tm_mday     ) << 16
-         | (DWORD)(ptm->tm_hour     ) << 11
-         | (DWORD)(ptm->tm_min      ) << 5
-         | (DWORD)(ptm->tm_sec/2    );
+    fattime_mutex.lock();
+    struct tm t = *localtime(&rawtime);
+    fattime_mutex.unlock();
+    return (DWORD)(t.tm_year - 80) << 25
+         | (DWORD)(t.tm_mon + 1  ) << 21
+         | (DWORD)(t.tm_mday     ) << 16
+         | (DWORD)(t.tm_hour     ) << 11
+         | (DWORD)(t.tm_min      ) << 5
+         | (DWORD)(t.tm_sec/2    );
+}
+
+#if _USE_LFN == 3
+/* Each FatFs call takes its own LFN working buffer, so that the volumes can
+ * be used at the same time. The rtos library locks the heap for the threads */
+void *ff_memalloc(UINT size) {
+    return malloc(size);
 }
 
+void ff_memfree(void *block) {
+    free(block);
+}
+#endif
+
+#if _FS_REENTRANT
+/* FatFs locks a volume with the mutex of its FATFileSystem, which the file
+ * and directory handles also take around their own sequences of calls. The
+ * mutex is recursive, and the volumes do not wait for each other. */
+int ff_cre_syncobj(BYTE vol, _SYNC_t *sobj) {
+    if (FATFileSystem::_ffs[vol] == NULL) {
+        return 0;
+    }
+    *sobj = &FATFileSystem::_ffs[vol]->_mutex;
+    return 1;
+}
+
+int ff_req_grant(_SYNC_t sobj) {
+    static_cast<PlatformMutex*>(sobj)->lock();
+    return 1;
+}
+
+void ff_rel_grant(_SYNC_t sobj) {
+    static_cast<PlatformMutex*>(sobj)->unlock();
+}
+
+int ff_del_syncobj(_SYNC_t sobj) {
+    return 1;
+}
+#endif
+
 FATFileSystem *FATFileSystem::_ffs[_VOLUMES] = {0};
 
-FATFileSystem::FATFileSystem(const char* n) : FileSystemLike(n) {
+#if _USE_LFN == 1 && _VOLUMES > 1
+PlatformMutex FATFileSystem::_mutex;
+#endif
+
+FATFileSystem::FATFileSystem(const char* n) : FileSystemLike(n), _cache(this) {
     debug_if(FFS_DBG, "FATFileSystem(%s)\n", n);
+#if _USE_DIRCACHE
+    _fs.dcache = NULL;
+    _fs.dcsize = 0;
+#endif
     for(int i=0; i<_VOLUMES; i++) {
         if(_ffs[i] == 0) {
             _ffs[i] = this;
@@ -63,6 +114,7 @@ FATFileSystem::~FATFileSystem() {
             f_mount(i, NULL);
         }
     }
+    disable_dir_cache();
 }
 
 FileHandle *FATFileSystem::open(const char* name, int flags) {
@@ -88,19 +140,55 @@ FileHandle *FATFileSystem::open(const char* name, int flags) {
     }
     
     FIL fh;
+    _mutex.lock();
     FRESULT res = f_open(&fh, n, openmode);
+    if (res == 0 && (flags & O_APPEND)) {
+        f_lseek(&fh, fh.fsize);
+    }
+    _mutex.unlock();
     if (res) { 
         debug_if(FFS_DBG, "f_open('w') failed: %d\n", res);
         return NULL;
     }
-    if (flags & O_APPEND) {
-        f_lseek(&fh, fh.fsize);
-    }
-    return new FATFileHandle(fh);
+    return new FATFileHandle(fh, &_mutex);
 }
     
+FileHandle *FATFileSystem::open_prealloc(const char *name, size_t size) {
+    FATFileHandle *fh = static_cast<FATFileHandle*>(open(name, O_WRONLY | O_CREAT | O_TRUNC));
+    if (fh == NULL) {
+        return NULL;
+    }
+    if (fh->reserve(size)) {
+        fh->close();
+        return NULL;
+    }
+    return fh;
+}
+
+int FATFileSystem::disk_read(uint8_t *buffer, uint64_t sector, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (disk_read(buffer + i * 512, sector + i)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int FATFileSystem::disk_write(const uint8_t *buffer, uint64_t sector, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (disk_write(buffer + i * 512, sector + i)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 int FATFileSystem::remove(const char *filename) {
-    FRESULT res = f_unlink(filename);
+    char n[64];
+    sprintf(n, "%d:/%s", _fsid, filename);
+    _mutex.lock();
+    FRESULT res = f_unlink(n);
+    _mutex.unlock();
     if (res) { 
         debug_if(FFS_DBG, "f_unlink() failed: %d\n", res);
         return -1;
@@ -109,7 +197,9 @@ int FATFileSystem::remove(const char *filename) {
 }
 
 int FATFileSystem::format() {
+    _mutex.lock();
     FRESULT res = f_mkfs(_fsid, 0, 512); // Logical drive number, Partitioning rule, Allocation unit size (bytes per cluster)
+    _mutex.unlock();
     if (res) {
         debug_if(FFS_DBG, "f_mkfs() failed: %d\n", res);
         return -1;
@@ -119,14 +209,58 @@ int FATFileSystem::format() {
 
 DirHandle *FATFileSystem::opendir(const char *name) {
     FATFS_DIR dir;
-    FRESULT res = f_opendir(&dir, name);
+    char n[64];
+    sprintf(n, "%d:/%s", _fsid, name);
+    _mutex.lock();
+    FRESULT res = f_opendir(&dir, n);
+    _mutex.unlock();
     if (res != 0) {
         return NULL;
     }
-    return new FATDirHandle(dir);
+    return new FATDirHandle(dir, &_mutex);
 }
 
 int FATFileSystem::mkdir(const char *name, mode_t mode) {
-    FRESULT res = f_mkdir(name);
+    char n[64];
+    sprintf(n, "%d:/%s", _fsid, name);
+    _mutex.lock();
+    FRESULT res = f_mkdir(n);
+    _mutex.unlock();
     return res == 0 ? 0 : -1;
 }
+
+int FATFileSystem::enable_dir_cache(int entries) {
+#if _USE_DIRCACHE
+    if (entries <= 0) {
+        return -1;
+    }
+    entries = (entries + 1) & ~1;
+    DIRCACHE *table = (DIRCACHE*)malloc(entries * sizeof(DIRCACHE));
+    if (table == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < entries; i++) {
+        table[i].sclust = 0xFFFFFFFF;
+    }
+    _mutex.lock();
+    DIRCACHE *old = _fs.dcache;
+    _fs.dcache = table;
+    _fs.dcsize = entries;
+    _mutex.unlock();
+    free(old);
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+void FATFileSystem::disable_dir_cache() {
+#if _USE_DIRCACHE
+    _mutex.lock();
+    DIRCACHE *old = _fs.dcache;
+    _fs.dcache = NULL;
+    _fs.dcsize = 0;
+    _mutex.unlock();
+    free(old);
+#endif
+}
@@ -24,11 +24,18 @@
 
 #include "FileSystemLike.h"
 #include "FileHandle.h"
+#include "PlatformMutex.h"
+#include "FATSectorCache.h"
 #include "ff.h"
 #include <stdint.h>
 
 using namespace mbed;
 
+/* Default size of the directory lookup cache, in entries of 16 bytes */
+#ifndef FAT_DIR_CACHE_ENTRIES
+#define FAT_DIR_CACHE_ENTRIES   64
+#endif
+
 class FATFileSystem : public FileSystemLike {
 public:
 
@@ -38,20 +45,66 @@ public:
     static FATFileSystem * _ffs[_VOLUMES];   // FATFileSystem objects, as parallel to FatFs drives array
     FATFS _fs;                               // Work area (file system object) for logical drive
     int _fsid;
+    FATSectorCache _cache;                   // Sector cache between FatFs and the disk
 
     virtual FileHandle *open(const char* name, int flags);
+
+    /** Create a file, or empty it, with size bytes of contiguous clusters
+     *  reserved for it (see FATFileHandle::reserve())
+     *
+     *  @returns
+     *    The file, open for writing, or NULL on error
+     */
+    FileHandle *open_prealloc(const char *name, size_t size);
     virtual int remove(const char *filename);
     virtual int format();
     virtual DirHandle *opendir(const char *name);
     virtual int mkdir(const char *name, mode_t mode);
 
+    /** Remember where the names looked up on this volume were found, so
+     *  that opening a file again does not scan its directory
+     *
+     *  Without the cache, each open, stat or remove reads and compares the
+     *  entries of the directory from the start, which is slow in directories
+     *  of thousands of files. The cache is a hash table of sets of 2 slots:
+     *  names which fall in the same set replace the least recently used, and
+     *  a location is checked against the directory before it is used.
+     *
+     *  @param entries The number of slots, rounded up to an even number
+     *
+     *  @returns
+     *    0 on success,
+     *   -1 if the memory could not be allocated
+     */
+    int enable_dir_cache(int entries = FAT_DIR_CACHE_ENTRIES);
+
+    /** Free the directory lookup cache
+     */
+    void disable_dir_cache();
+
     virtual int disk_initialize() { return 0; }
     virtual int disk_status() { return 0; }
     virtual int disk_read(uint8_t * buffer, uint64_t sector) = 0;
     virtual int disk_write(const uint8_t * buffer, uint64_t sector) = 0;
+
+    /* Read or write count consecutive sectors. The default calls the
+     * single sector functions in turn; disks which can transfer several
+     * sectors with one command should override them. */
+    virtual int disk_read(uint8_t * buffer, uint64_t sector, uint32_t count);
+    virtual int disk_write(const uint8_t * buffer, uint64_t sector, uint32_t count);
     virtual int disk_sync() { return 0; }
     virtual uint64_t disk_sectors() = 0;
 
+    /* Serializes the FatFs calls on this volume, from the file system and
+     * from its open files and directories; it is also the sync object of
+     * the volume in FatFs (_FS_REENTRANT), so direct f_xxx() calls on the
+     * volume are serialized too */
+#if _USE_LFN == 1 && _VOLUMES > 1
+    // the LFN working buffer of FatFs is shared by all the volumes
+    static PlatformMutex _mutex;
+#else
+    PlatformMutex _mutex;
+#endif
 };
 
 #endif
@@ -0,0 +1,182 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2012 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <string.h>
+
+#include "FATSectorCache.h"
+#include "FATFileSystem.h"
+
+FATSectorCache::FATSectorCache(FATFileSystem *disk) : _disk(disk) {
+    invalidate();
+    reset_stats();
+}
+
+void FATSectorCache::reset_stats() {
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+#if FAT_CACHE_WAYS > 0
+
+FATSectorCache::Line *FATSectorCache::find(uint32_t sector) {
+    Line *set = &_lines[(sector % FAT_CACHE_SETS) * FAT_CACHE_WAYS];
+    for (int i = 0; i < FAT_CACHE_WAYS; i++) {
+        if (set[i].valid && set[i].sector == sector) {
+            set[i].used = ++_clock;
+            return &set[i];
+        }
+    }
+    return NULL;
+}
+
+/* Free the least recently used line of the set of sector, writing it back
+ * if it is dirty; NULL if that write failed */
+FATSectorCache::Line *FATSectorCache::evict(uint32_t sector) {
+    Line *set = &_lines[(sector % FAT_CACHE_SETS) * FAT_CACHE_WAYS];
+    Line *victim = &set[0];
+    for (int i = 0; i < FAT_CACHE_WAYS; i++) {
+        if (!set[i].valid) {
+            victim = &set[i];
+            break;
+        }
+        if ((int32_t)(set[i].used - victim->used) < 0) {
+            victim = &set[i];
+        }
+    }
+    if (write_back(victim)) {
+        return NULL;
+    }
+    victim->valid = false;
+    victim->sector = sector;
+    victim->used = ++_clock;
+    return victim;
+}
+
+int FATSectorCache::write_back(Line *line) {
+    if (line->valid && line->dirty) {
+        if (_disk->disk_write(data(line), line->sector, 1)) {
+            return 1;
+        }
+        line->dirty = false;
+        _stats.writebacks++;
+    }
+    return 0;
+}
+
+int FATSectorCache::read(uint8_t *buffer, uint32_t sector, uint32_t count) {
+    if (count > 1) {
+        // read the run, then take the sectors the cache has newer copies of
+        _stats.bypassed += count;
+        if (_disk->disk_read(buffer, sector, count)) {
+            return 1;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            Line *line = find(sector + i);
+            if (line != NULL) {
+                memcpy(buffer + i * 512, data(line), 512);
+            }
+        }
+        return 0;
+    }
+
+    Line *line = find(sector);
+    if (line != NULL) {
+        _stats.hits++;
+    } else {
+        _stats.misses++;
+        line = evict(sector);
+        if (line == NULL || _disk->disk_read(data(line), sector, 1)) {
+            return 1;
+        }
+        line->valid = true;
+        line->dirty = false;
+    }
+    memcpy(buffer, data(line), 512);
+    return 0;
+}
+
+int FATSectorCache::write(const uint8_t *buffer, uint32_t sector, uint32_t count) {
+    if (count > 1) {
+        // write the run through, and update the copies in the cache
+        _stats.bypassed += count;
+        if (_disk->disk_write(buffer, sector, count)) {
+            return 1;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            Line *line = find(sector + i);
+            if (line != NULL) {
+                memcpy(data(line), buffer + i * 512, 512);
+                line->dirty = false;
+            }
+        }
+        return 0;
+    }
+
+    Line *line = find(sector);
+    if (line != NULL) {
+        _stats.hits++;
+    } else {
+        _stats.misses++;
+        line = evict(sector);
+        if (line == NULL) {
+            return 1;
+        }
+        line->valid = true;
+    }
+    memcpy(data(line), buffer, 512);
+    line->dirty = true;
+    return 0;
+}
+
+int FATSectorCache::flush() {
+    int result = 0;
+    for (int i = 0; i < FAT_CACHE_SETS * FAT_CACHE_WAYS; i++) {
+        if (write_back(&_lines[i])) {
+            result = 1;
+        }
+    }
+    return result;
+}
+
+void FATSectorCache::invalidate() {
+    memset(_lines, 0, sizeof(_lines));
+    _clock = 0;
+}
+
+#else
+
+int FATSectorCache::read(uint8_t *buffer, uint32_t sector, uint32_t count) {
+    _stats.bypassed += count;
+    return _disk->disk_read(buffer, sector, count);
+}
+
+int FATSectorCache::write(const uint8_t *buffer, uint32_t sector, uint32_t count) {
+    _stats.bypassed += count;
+    return _disk->disk_write(buffer, sector, count);
+}
+
+int FATSectorCache::flush() {
+    return 0;
+}
+
+void FATSectorCache::invalidate() {
+}
+
+#endif
@@ -0,0 +1,98 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2012 ARM Limited
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MBED_FATSECTORCACHE_H
+#define MBED_FATSECTORCACHE_H
+
+#include <stdint.h>
+
+/* Geometry of the sector cache of each volume: sectors are spread over
+ * FAT_CACHE_SETS sets by their number, and each set holds FAT_CACHE_WAYS
+ * sectors, replaced least recently used first. FAT_CACHE_WAYS 0 turns the
+ * cache off. */
+#ifndef FAT_CACHE_SETS
+#define FAT_CACHE_SETS      2
+#endif
+#ifndef FAT_CACHE_WAYS
+#define FAT_CACHE_WAYS      2
+#endif
+
+class FATFileSystem;
+
+/** A write-back cache of single sectors, between FatFs and the disk
+ *
+ * FatFs reads and writes the FAT and directory sectors one at a time,
+ * often the same few sectors over and over. Single sector accesses are
+ * kept in the cache, and written sectors stay dirty until flush(), which
+ * FatFs calls through CTRL_SYNC when a file is synced or closed and after
+ * it changed a directory. Runs of sectors, which are file data, bypass
+ * the cache.
+ */
+class FATSectorCache {
+public:
+    FATSectorCache(FATFileSystem *disk);
+
+    int read(uint8_t *buffer, uint32_t sector, uint32_t count);
+    int write(const uint8_t *buffer, uint32_t sector, uint32_t count);
+
+    /** Write the dirty sectors to the disk
+     *
+     *  @returns 0 on success, 1 if a sector could not be written
+     */
+    int flush();
+
+    /** Forget the content of the cache, dirty sectors included
+     */
+    void invalidate();
+
+    struct Stats {
+        uint32_t hits;          // single sector accesses served by the cache
+        uint32_t misses;        // single sector accesses which were not
+        uint32_t writebacks;    // dirty sectors written to the disk
+        uint32_t bypassed;      // sectors read or written in runs
+    };
+
+    const Stats &stats() const { return _stats; }
+    void reset_stats();
+
+private:
+#if FAT_CACHE_WAYS > 0
+    struct Line {
+        uint32_t sector;
+        uint32_t used;          // value of _clock when last used
+        bool valid;
+        bool dirty;
+    };
+
+    Line *find(uint32_t sector);
+    Line *evict(uint32_t sector);
+    int write_back(Line *line);
+    uint8_t *data(Line *line) { return _data[line - _lines]; }
+
+    Line _lines[FAT_CACHE_SETS * FAT_CACHE_WAYS];
+    uint8_t _data[FAT_CACHE_SETS * FAT_CACHE_WAYS][512];
+    uint32_t _clock;
+#endif
+    FATFileSystem *_disk;
+    Stats _stats;
+};
+
+#endif
@@ -52,16 +52,19 @@
  * card always responds to commands, data blocks and errors.
  *
  * The protocol supports a CRC, but by default it is off (except for the
- * first reset CMD0, where the CRC can just be pre-calculated, and CMD8)
- * I'll leave the CRC off I think!
+ * first reset CMD0, where the CRC can just be pre-calculated, and CMD8).
+ * Commands always carry their CRC7; building with SD_CRC set to 1 turns
+ * the CRC on with CMD59, and the CRC16 of data blocks is then sent and
+ * checked too.
  *
  * Standard capacity cards have variable data block sizes, whereas High
  * Capacity cards fix the size of data block to 512 bytes. I'll therefore
  * just always use the Standard Capacity cards with a block size of 512 bytes.
  * This is set with CMD16.
  *
- * You can read and write single blocks (CMD17, CMD25) or multiple blocks
- * (CMD18, CMD25). For simplicity, I'll just use single block accesses. When
+ * You can read and write single blocks (CMD17, CMD24) or multiple blocks
+ * (CMD18, CMD25). Single block accesses are used for one sector, and
+ * multiple block accesses when FatFs asks for a run of sectors. When
  * the card gets a read command, it responds with a response token, and then
  * a data token or an error.
  *
@@ -111,6 +114,25 @@
  * +------+---------+---------+- -  - -+---------+-----------+----------+
  * | 0xFE | data[0] | data[1] |        | data[n] | crc[15:8] | crc[7:0] |
  * +------+---------+---------+- -  - -+---------+-----------+----------+
+ *
+ * Multiple Block Read and Write
+ * -----------------------------
+ *
+ * After CMD18 the card sends data blocks, as above, until it gets
+ * STOP_TRANSMISSION (CMD12). The byte after CMD12 is a stuff byte, then
+ * comes an R1b response.
+ *
+ * After CMD25 each block sent starts with 0xFC instead of 0xFE and is
+ * acknowledged by a data response token, and the card is busy while it
+ * programs it. The transfer is ended by a 0xFD stop token, also followed
+ * by busy. Telling the card the number of blocks first (ACMD23) lets it
+ * erase them all at once.
+ *
+ * Clock
+ * -----
+ * Initialisation is done at 100kHz. Data is then transferred at the
+ * TRAN_SPEED of the CSD register (25MHz for most SD cards), or at
+ * SD_MAX_FREQUENCY if that is lower.
  */
 #include "SDFileSystem.h"
 #include "mbed_debug.h"
@@ -119,8 +141,18 @@
 
 #define SD_DBG             0
 
+// Highest SPI clock used for data transfers
+#ifndef SD_MAX_FREQUENCY
+#define SD_MAX_FREQUENCY   25000000
+#endif
+
+// Set to 1 to check the CRC of commands and data blocks
+#ifndef SD_CRC
+#define SD_CRC             0
+#endif
+
 SDFileSystem::SDFileSystem(PinName mosi, PinName miso, PinName sclk, PinName cs, const char* name) :
-    FATFileSystem(name), _spi(mosi, miso, sclk), _cs(cs) {
+    FATFileSystem(name), _spi(mosi, miso, sclk), _cs(cs), _transfer_sck(1000000) {
     _cs = 1;
 }
 
@@ -210,7 +242,16 @@ int SDFileSystem::disk_initialize() {
         return 1;
     }
     
-    _spi.frequency(1000000); // Set to 1MHz for data transfer
+#if SD_CRC
+    // Turn the CRC on (CMD59)
+    if (_cmd(59, 1) != 0) {
+        debug("Enable CRC timed out\n");
+        return 1;
+    }
+#endif
+    
+    debug_if(SD_DBG, "transfer clock: %d Hz\n", _transfer_sck);
+    _spi.frequency(_transfer_sck);
     return 0;
 }
 
@@ -221,8 +262,7 @@ int SDFileSystem::disk_write(const uint8_t *buffer, uint64_t block_number) {
     }
     
     // send the data block
-    _write(buffer, 512);
-    return 0;
+    return _write(buffer, 512);
 }
 
 int SDFileSystem::disk_read(uint8_t *buffer, uint64_t block_number) {
@@ -232,8 +272,69 @@ int SDFileSystem::disk_read(uint8_t *buffer, uint64_t block_number) {
     }
     
     // receive the data
-    _read(buffer, 512);
-    return 0;
+    return _read(buffer, 512);
+}
+
+int SDFileSystem::disk_write(const uint8_t *buffer, uint64_t block_number, uint32_t count) {
+    if (count == 1) {
+        return disk_write(buffer, block_number);
+    }
+    
+    // pre-erase the blocks (ACMD23); only a hint, so the result is ignored
+    _cmd(55, 0);
+    _cmd(23, count);
+    
+    // set write address for multiple blocks (CMD25)
+    if (_cmd(25, block_number * cdv) != 0) {
+        return 1;
+    }
+    
+    _cs = 0;
+    int result = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (_write_block(buffer, 512, 0xFC) != 0) {
+            result = 1;
+            break;
+        }
+        buffer += 512;
+    }
+    
+    // stop the transfer, even after an error
+    _spi.write(0xFD);
+    _spi.write(0xFF);
+    while (_spi.write(0xFF) == 0);
+    
+    _cs = 1;
+    _spi.write(0xFF);
+    return result;
+}
+
+int SDFileSystem::disk_read(uint8_t *buffer, uint64_t block_number, uint32_t count) {
+    if (count == 1) {
+        return disk_read(buffer, block_number);
+    }
+    
+    // set read address for multiple blocks (CMD18)
+    int r = _cmdx(18, block_number * cdv);
+    if (r != 0) {
+        if (r > 0) {
+            _cs = 1;
+            _spi.write(0xFF);
+        }
+        return 1;
+    }
+    
+    // receive the data, with cs still low
+    int result = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (_read_block(buffer, 512) != 0) {
+            result = 1;
+            break;
+        }
+        buffer += 512;
+    }
+    
+    return _stop_transmission() | result;
 }
 
 int SDFileSystem::disk_status() { return 0; }
@@ -242,16 +343,54 @@ uint64_t SDFileSystem::disk_sectors() { return _sectors; }
 
 
 // PRIVATE FUNCTIONS
+static uint8_t crc7(const uint8_t *data, int length) {
+    uint8_t crc = 0;
+    for (int i = 0; i < length; i++) {
+        uint8_t d = data[i];
+        for (int b = 0; b < 8; b++) {
+            crc <<= 1;
+            if ((d ^ crc) & 0x80) {
+                crc ^= 0x09;
+            }
+            d <<= 1;
+        }
+    }
+    return crc & 0x7F;
+}
+
+#if SD_CRC
+// CRC16-CCITT of data blocks
+static uint16_t crc16(const uint8_t *data, uint32_t length) {
+    uint16_t crc = 0;
+    for (uint32_t i = 0; i < length; i++) {
+        crc = (uint8_t)(crc >> 8) | (crc << 8);
+        crc ^= data[i];
+        crc ^= (uint8_t)(crc & 0xFF) >> 4;
+        crc ^= crc << 12;
+        crc ^= (crc & 0xFF) << 5;
+    }
+    return crc;
+}
+#endif
+
+void SDFileSystem::_send_cmd(int cmd, int arg) {
+    uint8_t frame[6];
+    frame[0] = 0x40 | cmd;
+    frame[1] = arg >> 24;
+    frame[2] = arg >> 16;
+    frame[3] = arg >> 8;
+    frame[4] = arg >> 0;
+    frame[5] = (crc7(frame, 5) << 1) | 1;
+    for (int i = 0; i < 6; i++) {
+        _spi.write(frame[i]);
+    }
+}
+
 int SDFileSystem::_cmd(int cmd, int arg) {
     _cs = 0;
     
     // send a command
-    _spi.write(0x40 | cmd);
-    _spi.write(arg >> 24);
-    _spi.write(arg >> 16);
-    _spi.write(arg >> 8);
-    _spi.write(arg >> 0);
-    _spi.write(0x95);
+    _send_cmd(cmd, arg);
     
     // wait for the repsonse (response[7] == 0)
     for (int i = 0; i < SD_COMMAND_TIMEOUT; i++) {
@@ -270,12 +409,7 @@ int SDFileSystem::_cmdx(int cmd, int arg) {
     _cs = 0;
     
     // send a command
-    _spi.write(0x40 | cmd);
-    _spi.write(arg >> 24);
-    _spi.write(arg >> 16);
-    _spi.write(arg >> 8);
-    _spi.write(arg >> 0);
-    _spi.write(0x95);
+    _send_cmd(cmd, arg);
     
     // wait for the repsonse (response[7] == 0)
     for (int i = 0; i < SD_COMMAND_TIMEOUT; i++) {
@@ -292,15 +426,9 @@ int SDFileSystem::_cmdx(int cmd, int arg) {
 
 int SDFileSystem::_cmd58() {
     _cs = 0;
-    int arg = 0;
     
     // send a command
-    _spi.write(0x40 | 58);
-    _spi.write(arg >> 24);
-    _spi.write(arg >> 16);
-    _spi.write(arg >> 8);
-    _spi.write(arg >> 0);
-    _spi.write(0x95);
+    _send_cmd(58, 0);
     
     // wait for the repsonse (response[7] == 0)
     for (int i = 0; i < SD_COMMAND_TIMEOUT; i++) {
@@ -349,52 +477,105 @@ int SDFileSystem::_cmd8() {
     return -1; // timeout
 }
 
-int SDFileSystem::_read(uint8_t *buffer, uint32_t length) {
-    _cs = 0;
+int SDFileSystem::_stop_transmission() {
+    // send STOP_TRANSMISSION (CMD12)
+    _send_cmd(12, 0);
+    
+    // skip the stuff byte, then wait for the response (response[7] == 0)
+    _spi.write(0xFF);
+    int response = -1;
+    for (int i = 0; i < SD_COMMAND_TIMEOUT; i++) {
+        response = _spi.write(0xFF);
+        if (!(response & 0x80)) {
+            break;
+        }
+    }
     
-    // read until start byte (0xFF)
-    while (_spi.write(0xFF) != 0xFE);
+    // wait while busy
+    while (_spi.write(0xFF) == 0);
+    
+    _cs = 1;
+    _spi.write(0xFF);
+    return response != 0;
+}
+
+int SDFileSystem::_read_block(uint8_t *buffer, uint32_t length) {
+    // read until start byte (0xFE), or an error token
+    int token;
+    while ((token = _spi.write(0xFF)) == 0xFF);
+    if (token != 0xFE) {
+        debug_if(SD_DBG, "read error token 0x%02x\n", token);
+        return 1;
+    }
     
     // read data
+#if DEVICE_SPI_BLOCK
+    _spi.transfer(NULL, buffer, length);
+#else
     for (uint32_t i = 0; i < length; i++) {
         buffer[i] = _spi.write(0xFF);
     }
-    _spi.write(0xFF); // checksum
-    _spi.write(0xFF);
-    
-    _cs = 1;
-    _spi.write(0xFF);
+#endif
+    uint16_t crc = _spi.write(0xFF) << 8; // checksum
+    crc |= _spi.write(0xFF);
+#if SD_CRC
+    if (crc != crc16(buffer, length)) {
+        debug_if(SD_DBG, "read CRC error\n");
+        return 1;
+    }
+#else
+    (void)crc;
+#endif
     return 0;
 }
 
-int SDFileSystem::_write(const uint8_t*buffer, uint32_t length) {
-    _cs = 0;
-    
+int SDFileSystem::_write_block(const uint8_t *buffer, uint32_t length, int token) {
     // indicate start of block
-    _spi.write(0xFE);
+    _spi.write(token);
     
     // write the data
+#if DEVICE_SPI_BLOCK
+    _spi.transfer(buffer, NULL, length);
+#else
     for (uint32_t i = 0; i < length; i++) {
         _spi.write(buffer[i]);
     }
+#endif
     
     // write the checksum
+#if SD_CRC
+    uint16_t crc = crc16(buffer, length);
+    _spi.write(crc >> 8);
+    _spi.write(crc & 0xFF);
+#else
     _spi.write(0xFF);
     _spi.write(0xFF);
+#endif
     
     // check the response token
     if ((_spi.write(0xFF) & 0x1F) != 0x05) {
-        _cs = 1;
-        _spi.write(0xFF);
         return 1;
     }
     
     // wait for write to finish
     while (_spi.write(0xFF) == 0);
-    
+    return 0;
+}
+
+int SDFileSystem::_read(uint8_t *buffer, uint32_t length) {
+    _cs = 0;
+    int result = _read_block(buffer, length);
     _cs = 1;
     _spi.write(0xFF);
-    return 0;
+    return result;
+}
+
+int SDFileSystem::_write(const uint8_t*buffer, uint32_t length) {
+    _cs = 0;
+    int result = _write_block(buffer, length, 0xFE);
+    _cs = 1;
+    _spi.write(0xFF);
+    return result;
 }
 
 static uint32_t ext_bits(unsigned char *data, int msb, int lsb) {
@@ -435,6 +616,16 @@ uint64_t SDFileSystem::_sd_sectors() {
     
     int csd_structure = ext_bits(csd, 127, 126);
     
+    // tran_speed    : csd[103:96] - transfer rate unit [2:0], time value [6:3]
+    static const int rate_unit[] = {10000, 100000, 1000000, 10000000};
+    static const int time_value[] = {0, 10, 12, 13, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 70, 80};
+    uint32_t tran_speed = ext_bits(csd, 103, 96);
+    int hz = (tran_speed & 0x4) ? 0 : rate_unit[tran_speed & 0x3] * time_value[(tran_speed >> 3) & 0xF];
+    _transfer_sck = (hz > SD_MAX_FREQUENCY) ? SD_MAX_FREQUENCY : hz;
+    if (_transfer_sck == 0) {
+        _transfer_sck = 1000000;
+    }
+    
     switch (csd_structure) {
         case 0:
             cdv = 512;
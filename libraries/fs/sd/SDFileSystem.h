@@ -56,11 +56,14 @@ public:
     virtual int disk_status();
     virtual int disk_read(uint8_t * buffer, uint64_t block_number);
     virtual int disk_write(const uint8_t * buffer, uint64_t block_number);
+    virtual int disk_read(uint8_t * buffer, uint64_t block_number, uint32_t count);
+    virtual int disk_write(const uint8_t * buffer, uint64_t block_number, uint32_t count);
     virtual int disk_sync();
     virtual uint64_t disk_sectors();
 
 protected:
 
+    void _send_cmd(int cmd, int arg);
     int _cmd(int cmd, int arg);
     int _cmdx(int cmd, int arg);
     int _cmd8();
@@ -71,12 +74,16 @@ protected:
     
     int _read(uint8_t * buffer, uint32_t length);
     int _write(const uint8_t *buffer, uint32_t length);
+    int _read_block(uint8_t * buffer, uint32_t length);
+    int _write_block(const uint8_t *buffer, uint32_t length, int token);
+    int _stop_transmission();
     uint64_t _sd_sectors();
     uint64_t _sectors;
     
     SPI _spi;
     DigitalOut _cs;
     int cdv;
+    int _transfer_sck;
 };
 
 #endif
@@ -0,0 +1,174 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BUFFEREDSERIAL_H
+#define MBED_BUFFEREDSERIAL_H
+
+#include "platform.h"
+
+#if DEVICE_SERIAL
+
+#include "SerialBase.h"
+#include "FileHandle.h"
+#include "serial_api.h"
+#include "us_ticker_api.h"
+
+namespace mbed {
+
+/** A serial port (UART) with interrupt driven transmit and receive buffers
+ *
+ * Data written is queued in a transmit buffer, which the transmit interrupt
+ * drains into the UART FIFO, as many characters at a time as the FIFO takes.
+ * Data received is moved by the receive interrupt into a receive buffer,
+ * and characters that do not fit are dropped and counted as overruns.
+ *
+ * Each buffer has a single producer and a single consumer (the interrupt on
+ * one side, the application on the other), so neither needs locking; the
+ * application side must not be used from more than one thread at a time.
+ *
+ * Reads and writes block until they are done or the timeout expires. While
+ * blocked, they give up the processor with osDelay() when the RTOS is linked.
+ *
+ * The serial interrupts are used by the buffers: do not attach() other
+ * functions to them.
+ *
+ * A BufferedSerial is a FileHandle, so it can be made the console with
+ * set_console(): each line printed to stdout is then a single write().
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ * #include "BufferedSerial.h"
+ *
+ * BufferedSerial pc(USBTX, USBRX);
+ *
+ * int main() {
+ *     char buf[32];
+ *     pc.baud(921600);
+ *     pc.set_timeout(100);
+ *     while (1) {
+ *         int n = pc.read(buf, sizeof(buf));
+ *         pc.write(buf, n);
+ *     }
+ * }
+ * @endcode
+ */
+class BufferedSerial : public SerialBase, public FileHandle {
+
+public:
+    /** Create a BufferedSerial port, connected to the specified transmit and receive pins
+     *
+     *  @param tx Transmit pin
+     *  @param rx Receive pin
+     *  @param tx_size Size of the transmit buffer in bytes
+     *  @param rx_size Size of the receive buffer in bytes
+     *
+     *  @note
+     *    Either tx or rx may be specified as NC if unused
+     */
+    BufferedSerial(PinName tx, PinName rx, int tx_size = 256, int rx_size = 256);
+
+    virtual ~BufferedSerial();
+
+    /** Write a char to the serial port
+     *
+     * @param c The char to write
+     *
+     * @returns The written char or -1 if the timeout expired
+     */
+    int putc(int c);
+
+    /** Read a char from the serial port
+     *
+     * @returns The char read from the serial port, or -1 if the timeout expired
+     */
+    int getc();
+
+    /** Write a block of data to the serial port
+     *
+     *  @param buffer The data to write
+     *  @param length The number of bytes to write
+     *
+     *  @returns
+     *    The number of bytes queued, less than length if the timeout expired
+     */
+    virtual ssize_t write(const void *buffer, size_t length);
+
+    /** Read a block of data from the serial port
+     *
+     *  @param buffer Buffer for the data read
+     *  @param length The number of bytes to read
+     *
+     *  @returns
+     *    The number of bytes read, less than length if the timeout expired
+     */
+    virtual ssize_t read(void *buffer, size_t length);
+
+    /** Get the number of bytes waiting in the receive buffer
+     */
+    int readable();
+
+    /** Get the free space in the transmit buffer, in bytes
+     */
+    int writeable();
+
+    /** Set the timeout of blocking calls
+     *
+     *  @param ms Timeout in milliseconds; 0 to never block, -1 (default) to wait forever
+     */
+    void set_timeout(int ms);
+
+    /** Get the number of received bytes dropped because the receive buffer was full
+     */
+    unsigned int rx_overruns() const {
+        return _rx_overruns;
+    }
+
+    /** Wait, within the timeout, until the transmit buffer is empty
+     *
+     *  @returns
+     *    0 on success, -1 if the timeout expired
+     */
+    virtual int fsync();
+
+    virtual int close();
+    virtual int isatty();
+    virtual off_t lseek(off_t offset, int whence);
+
+protected:
+    void rx_irq();
+    void tx_irq();
+    void tx_start();
+    bool wait(us_timestamp_t start);
+
+    char *_tx_buf;
+    int _tx_size;
+    volatile int _tx_head;  // written by the application
+    volatile int _tx_tail;  // written by the transmit interrupt
+
+    char *_rx_buf;
+    int _rx_size;
+    volatile int _rx_head;  // written by the receive interrupt
+    volatile int _rx_tail;  // written by the application
+
+    volatile unsigned int _rx_overruns;
+    int _timeout;
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
@@ -17,7 +17,7 @@
 #define MBED_BUSIN_H
 
 #include "platform.h"
-#include "DigitalIn.h"
+#include "BusPorts.h"
 
 namespace mbed {
 
@@ -59,7 +59,7 @@ public:
 #endif
 
 protected:
-    DigitalIn* _pin[16];
+    BusPorts _bus;
 };
 
 } // namespace mbed
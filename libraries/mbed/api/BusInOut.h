@@ -16,7 +16,7 @@
 #ifndef MBED_BUSINOUT_H
 #define MBED_BUSINOUT_H
 
-#include "DigitalInOut.h"
+#include "BusPorts.h"
 
 namespace mbed {
 
@@ -85,7 +85,7 @@ public:
 #endif
 
 protected:
-    DigitalInOut* _pin[16];
+    BusPorts _bus;
 };
 
 } // namespace mbed
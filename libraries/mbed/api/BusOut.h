@@ -16,7 +16,7 @@
 #ifndef MBED_BUSOUT_H
 #define MBED_BUSOUT_H
 
-#include "DigitalOut.h"
+#include "BusPorts.h"
 
 namespace mbed {
 
@@ -68,7 +68,7 @@ public:
 #endif
 
 protected:
-    DigitalOut* _pin[16];
+    BusPorts _bus;
 };
 
 } // namespace mbed
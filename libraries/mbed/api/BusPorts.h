@@ -0,0 +1,73 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_BUSPORTS_H
+#define MBED_BUSPORTS_H
+
+#include "platform.h"
+#include "gpio_api.h"
+
+#if DEVICE_PORT_PINMAP
+#include "port_api.h"
+#endif
+
+namespace mbed {
+
+/** The pins of a bus, as used by BusOut, BusIn and BusInOut
+ *
+ * When the target can map pins to ports (DEVICE_PORT_PINMAP), the pins are
+ * grouped by port when the bus is created, and every access is a single
+ * masked port_write() or port_read() per port: the pins of a port change
+ * together, and a bus that lies within one port is updated in one store,
+ * which leaves the other pins of the port alone.
+ * Otherwise every pin is accessed on its own.
+ */
+class BusPorts {
+public:
+    BusPorts();
+    ~BusPorts();
+
+    /** Connect the bus to its pins, bit i of the bus to pins[i] (or NC)
+     */
+    void init(PinName pins[16], PinDirection dir);
+
+    void write(int value);
+    int read();
+    void dir(PinDirection dir);
+    void mode(PinMode pull);
+
+private:
+#if DEVICE_PORT_PINMAP
+    struct Group {
+        port_t port;
+        // bus bits on this port
+        uint16_t bus_mask;
+        // port bit = bus bit + shift, for all of bus_mask; otherwise
+        // the bits are scattered and looked up in _port_bit
+        bool linear;
+        signed char shift;
+    };
+
+    Group *_groups;
+    int _ngroups;
+    unsigned char _port_bit[16];
+#else
+    gpio_t *_pin[16];
+#endif
+};
+
+} // namespace mbed
+
+#endif
@@ -23,6 +23,7 @@
 #include "can_api.h"
 #include "can_helper.h"
 #include "FunctionPointer.h"
+#include "Callback.h"
 
 namespace mbed {
 
@@ -229,11 +230,18 @@ public:
         }
     }
 
+    /** Attach a callback to call whenever a CAN interrupt is generated.
+     *
+     *  @param func A callback, or an empty callback to set as none
+     *  @param type Which CAN interrupt to attach the callback to (CAN::RxIrq for message received, TxIrq for transmitted or aborted, EwIrq for error warning, DoIrq for data overrun, WuIrq for wake-up, EpIrq for error passive, AlIrq for arbitration lost, BeIrq for bus error)
+     */
+    void attach(Callback<void()> func, IrqType type=RxIrq);
+
     static void _irq_handler(uint32_t id, CanIrqType type);
 
 protected:
     can_t           _can;
-    FunctionPointer _irq[9];
+    Callback<void()> _irq[9];
 };
 
 } // namespace mbed
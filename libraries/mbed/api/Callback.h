@@ -0,0 +1,414 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_CALLBACK_H
+#define MBED_CALLBACK_H
+
+#include <string.h>
+
+namespace mbed {
+
+/** A typed callback: a static function, a member function bound to an
+ *  object, or a static function bound to a context pointer
+ *
+ * The target is stored inline (no heap allocation) together with a typed
+ * thunk, so calling a Callback is always a single indirect call, with no
+ * test on the kind of target. An empty Callback calls a function that does
+ * nothing and returns R().
+ *
+ * Callback<R()>, Callback<R(A0)> and Callback<R(A0, A1)> are provided.
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ *
+ * DigitalOut led(LED1);
+ * Ticker ticker;
+ *
+ * void toggle(DigitalOut *out) {
+ *     *out = !*out;
+ * }
+ *
+ * int main() {
+ *     ticker.attach(Callback<void()>(toggle, &led), 0.5);
+ * }
+ * @endcode
+ */
+template<typename F>
+class Callback;
+
+template<typename R>
+class Callback<R()> {
+public:
+    /** Create a Callback for a static function
+     *
+     *  @param function The static function to attach (default is none)
+     */
+    Callback(R (*function)() = 0) {
+        attach(function);
+    }
+
+    /** Create a Callback for a member function
+     *
+     *  @param object The object pointer to invoke the member function on (i.e. the this pointer)
+     *  @param member The address of the member function to attach
+     */
+    template<typename T>
+    Callback(T *object, R (T::*member)()) {
+        attach(object, member);
+    }
+
+    /** Create a Callback for a static function bound to a context pointer
+     *
+     *  @param function The static function to attach, called with 'context' as its first argument
+     *  @param context The pointer passed to 'function'
+     */
+    template<typename T>
+    Callback(R (*function)(T*), T *context) {
+        attach(function, context);
+    }
+
+    /** Attach a static function
+     *
+     *  @param function The static function to attach (default is none)
+     */
+    void attach(R (*function)() = 0) {
+        memcpy(&_target, &function, sizeof(function));
+        _object = 0;
+        _thunk = function ? &Callback::function_thunk : &Callback::null_thunk;
+    }
+
+    /** Attach a member function
+     *
+     *  @param object The object pointer to invoke the member function on (i.e. the this pointer)
+     *  @param member The address of the member function to attach
+     */
+    template<typename T>
+    void attach(T *object, R (T::*member)()) {
+        memcpy(&_target, (char*)&member, sizeof(member));
+        _object = static_cast<void*>(object);
+        _thunk = &Callback::member_thunk<T>;
+    }
+
+    /** Attach a static function bound to a context pointer
+     *
+     *  @param function The static function to attach, called with 'context' as its first argument
+     *  @param context The pointer passed to 'function'
+     */
+    template<typename T>
+    void attach(R (*function)(T*), T *context) {
+        memcpy(&_target, &function, sizeof(function));
+        _object = static_cast<void*>(context);
+        _thunk = &Callback::bound_thunk<T>;
+    }
+
+    /** Call the attached function
+     */
+    R call() const {
+        return _thunk(_object, &_target);
+    }
+
+    /** Check if a function is attached
+     */
+    bool attached() const {
+        return _thunk != &Callback::null_thunk;
+    }
+
+#ifdef MBED_OPERATORS
+    R operator ()() const {
+        return call();
+    }
+#endif
+
+private:
+    static R null_thunk(void *object, const void *target) {
+        return R();
+    }
+
+    static R function_thunk(void *object, const void *target) {
+        R (*f)();
+        memcpy(&f, target, sizeof(f));
+        return f();
+    }
+
+    template<typename T>
+    static R member_thunk(void *object, const void *target) {
+        R (T::*m)();
+        memcpy((char*)&m, target, sizeof(m));
+        return (static_cast<T*>(object)->*m)();
+    }
+
+    template<typename T>
+    static R bound_thunk(void *object, const void *target) {
+        R (*f)(T*);
+        memcpy(&f, target, sizeof(f));
+        return f(static_cast<T*>(object));
+    }
+
+    // the attached function - raw member function pointers need up to 16 bytes
+    union {
+        void (*function)(void);
+        void *pointer;
+        char member[16];
+    } _target;
+    // object or context pointer - 0 if none
+    void *_object;
+    // typed caller that converts _target back and calls it on _object
+    R (*_thunk)(void*, const void*);
+};
+
+template<typename R, typename A0>
+class Callback<R(A0)> {
+public:
+    /** Create a Callback for a static function
+     *
+     *  @param function The static function to attach (default is none)
+     */
+    Callback(R (*function)(A0) = 0) {
+        attach(function);
+    }
+
+    /** Create a Callback for a member function
+     *
+     *  @param object The object pointer to invoke the member function on (i.e. the this pointer)
+     *  @param member The address of the member function to attach
+     */
+    template<typename T>
+    Callback(T *object, R (T::*member)(A0)) {
+        attach(object, member);
+    }
+
+    /** Create a Callback for a static function bound to a context pointer
+     *
+     *  @param function The static function to attach, called with 'context' as its first argument
+     *  @param context The pointer passed to 'function'
+     */
+    template<typename T>
+    Callback(R (*function)(T*, A0), T *context) {
+        attach(function, context);
+    }
+
+    /** Attach a static function
+     *
+     *  @param function The static function to attach (default is none)
+     */
+    void attach(R (*function)(A0) = 0) {
+        memcpy(&_target, &function, sizeof(function));
+        _object = 0;
+        _thunk = function ? &Callback::function_thunk : &Callback::null_thunk;
+    }
+
+    /** Attach a member function
+     *
+     *  @param object The object pointer to invoke the member function on (i.e. the this pointer)
+     *  @param member The address of the member function to attach
+     */
+    template<typename T>
+    void attach(T *object, R (T::*member)(A0)) {
+        memcpy(&_target, (char*)&member, sizeof(member));
+        _object = static_cast<void*>(object);
+        _thunk = &Callback::member_thunk<T>;
+    }
+
+    /** Attach a static function bound to a context pointer
+     *
+     *  @param function The static function to attach, called with 'context' as its first argument
+     *  @param context The pointer passed to 'function'
+     */
+    template<typename T>
+    void attach(R (*function)(T*, A0), T *context) {
+        memcpy(&_target, &function, sizeof(function));
+        _object = static_cast<void*>(context);
+        _thunk = &Callback::bound_thunk<T>;
+    }
+
+    /** Call the attached function
+     */
+    R call(A0 a0) const {
+        return _thunk(_object, &_target, a0);
+    }
+
+    /** Check if a function is attached
+     */
+    bool attached() const {
+        return _thunk != &Callback::null_thunk;
+    }
+
+#ifdef MBED_OPERATORS
+    R operator ()(A0 a0) const {
+        return call(a0);
+    }
+#endif
+
+private:
+    static R null_thunk(void *object, const void *target, A0) {
+        return R();
+    }
+
+    static R function_thunk(void *object, const void *target, A0 a0) {
+        R (*f)(A0);
+        memcpy(&f, target, sizeof(f));
+        return f(a0);
+    }
+
+    template<typename T>
+    static R member_thunk(void *object, const void *target, A0 a0) {
+        R (T::*m)(A0);
+        memcpy((char*)&m, target, sizeof(m));
+        return (static_cast<T*>(object)->*m)(a0);
+    }
+
+    template<typename T>
+    static R bound_thunk(void *object, const void *target, A0 a0) {
+        R (*f)(T*, A0);
+        memcpy(&f, target, sizeof(f));
+        return f(static_cast<T*>(object), a0);
+    }
+
+    // the attached function - raw member function pointers need up to 16 bytes
+    union {
+        void (*function)(void);
+        void *pointer;
+        char member[16];
+    } _target;
+    // object or context pointer - 0 if none
+    void *_object;
+    // typed caller that converts _target back and calls it on _object
+    R (*_thunk)(void*, const void*, A0);
+};
+
+template<typename R, typename A0, typename A1>
+class Callback<R(A0, A1)> {
+public:
+    /** Create a Callback for a static function
+     *
+     *  @param function The static function to attach (default is none)
+     */
+    Callback(R (*function)(A0, A1) = 0) {
+        attach(function);
+    }
+
+    /** Create a Callback for a member function
+     *
+     *  @param object The object pointer to invoke the member function on (i.e. the this pointer)
+     *  @param member The address of the member function to attach
+     */
+    template<typename T>
+    Callback(T *object, R (T::*member)(A0, A1)) {
+        attach(object, member);
+    }
+
+    /** Create a Callback for a static function bound to a context pointer
+     *
+     *  @param function The static function to attach, called with 'context' as its first argument
+     *  @param context The pointer passed to 'function'
+     */
+    template<typename T>
+    Callback(R (*function)(T*, A0, A1), T *context) {
+        attach(function, context);
+    }
+
+    /** Attach a static function
+     *
+     *  @param function The static function to attach (default is none)
+     */
+    void attach(R (*function)(A0, A1) = 0) {
+        memcpy(&_target, &function, sizeof(function));
+        _object = 0;
+        _thunk = function ? &Callback::function_thunk : &Callback::null_thunk;
+    }
+
+    /** Attach a member function
+     *
+     *  @param object The object pointer to invoke the member function on (i.e. the this pointer)
+     *  @param member The address of the member function to attach
+     */
+    template<typename T>
+    void attach(T *object, R (T::*member)(A0, A1)) {
+        memcpy(&_target, (char*)&member, sizeof(member));
+        _object = static_cast<void*>(object);
+        _thunk = &Callback::member_thunk<T>;
+    }
+
+    /** Attach a static function bound to a context pointer
+     *
+     *  @param function The static function to attach, called with 'context' as its first argument
+     *  @param context The pointer passed to 'function'
+     */
+    template<typename T>
+    void attach(R (*function)(T*, A0, A1), T *context) {
+        memcpy(&_target, &function, sizeof(function));
+        _object = static_cast<void*>(context);
+        _thunk = &Callback::bound_thunk<T>;
+    }
+
+    /** Call the attached function
+     */
+    R call(A0 a0, A1 a1) const {
+        return _thunk(_object, &_target, a0, a1);
+    }
+
+    /** Check if a function is attached
+     */
+    bool attached() const {
+        return _thunk != &Callback::null_thunk;
+    }
+
+#ifdef MBED_OPERATORS
+    R operator ()(A0 a0, A1 a1) const {
+        return call(a0, a1);
+    }
+#endif
+
+private:
+    static R null_thunk(void *object, const void *target, A0, A1) {
+        return R();
+    }
+
+    static R function_thunk(void *object, const void *target, A0 a0, A1 a1) {
+        R (*f)(A0, A1);
+        memcpy(&f, target, sizeof(f));
+        return f(a0, a1);
+    }
+
+    template<typename T>
+    static R member_thunk(void *object, const void *target, A0 a0, A1 a1) {
+        R (T::*m)(A0, A1);
+        memcpy((char*)&m, target, sizeof(m));
+        return (static_cast<T*>(object)->*m)(a0, a1);
+    }
+
+    template<typename T>
+    static R bound_thunk(void *object, const void *target, A0 a0, A1 a1) {
+        R (*f)(T*, A0, A1);
+        memcpy(&f, target, sizeof(f));
+        return f(static_cast<T*>(object), a0, a1);
+    }
+
+    // the attached function - raw member function pointers need up to 16 bytes
+    union {
+        void (*function)(void);
+        void *pointer;
+        char member[16];
+    } _target;
+    // object or context pointer - 0 if none
+    void *_object;
+    // typed caller that converts _target back and calls it on _object
+    R (*_thunk)(void*, const void*, A0, A1);
+};
+
+} // namespace mbed
+
+#endif
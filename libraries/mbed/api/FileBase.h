@@ -42,6 +42,11 @@ typedef long off_t;
 
 #include "platform.h"
 
+/* Number of hash buckets the names of files and file systems are kept in */
+#ifndef FILEBASE_HASH_SIZE
+#define FILEBASE_HASH_SIZE  8
+#endif
+
 namespace mbed {
 
 typedef enum {
@@ -63,7 +68,10 @@ public:
     static FileBase *get(int n);
 
 protected:
-    static FileBase *_head;
+    static unsigned int hash(const char *name, unsigned int len);
+
+    // named objects, chained through _next by the hash of their name
+    static FileBase *_buckets[FILEBASE_HASH_SIZE];
 
     FileBase   *_next;
     const char *_name;
@@ -114,6 +114,16 @@ public:
     virtual ~FileHandle();
 };
 
+/** Send stdin, stdout and stderr to a FileHandle
+ *
+ *  Each write to the standard streams (for stdout, usually a line) is
+ *  passed to the console in a single write() call; reads from stdin ask it
+ *  for one character at a time.
+ *
+ *  @param console The FileHandle to use, or NULL for the default serial port
+ */
+void set_console(FileHandle *console);
+
 } // namespace mbed
 
 #endif
@@ -0,0 +1,238 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_FIXEDCALLCHAIN_H
+#define MBED_FIXEDCALLCHAIN_H
+
+#include "FunctionPointer.h"
+#include "CallChain.h"
+
+namespace mbed {
+
+/** A CallChain with a fixed capacity of N functions, stored inline
+ *
+ * Unlike CallChain, a FixedCallChain never allocates memory: the function
+ * objects live in the chain itself, and the pointers returned by add() and
+ * add_front() are handles into that storage, which remove() unlinks in
+ * constant time. Adding a function to a full chain returns NULL.
+ *
+ * N must be less than 255.
+ *
+ * Example:
+ * @code
+ * #include "mbed.h"
+ * #include "FixedCallChain.h"
+ *
+ * FixedCallChain<4> chain;
+ *
+ * void first(void) {
+ *     printf("'first' function.\n");
+ * }
+ *
+ * void second(void) {
+ *     printf("'second' function.\n");
+ * }
+ *
+ * int main() {
+ *     pFunctionPointer_t h = chain.add(second);
+ *     chain.add_front(first);
+ *     chain.call();
+ *     chain.remove(h);
+ * }
+ * @endcode
+ */
+template<int N>
+class FixedCallChain {
+public:
+    /** Create an empty chain
+     */
+    FixedCallChain() {
+        clear();
+    }
+
+    /** Add a function at the end of the chain
+     *
+     *  @param function A pointer to a void function
+     *
+     *  @returns
+     *  The function object for 'function', or NULL if the chain is full
+     */
+    pFunctionPointer_t add(void (*function)(void)) {
+        pFunctionPointer_t pf = alloc();
+        if (pf != NULL) {
+            pf->attach(function);
+            link_after(_prev[N], pf - _chain);
+        }
+        return pf;
+    }
+
+    /** Add a function at the end of the chain
+     *
+     *  @param tptr pointer to the object to call the member function on
+     *  @param mptr pointer to the member function to be called
+     *
+     *  @returns
+     *  The function object for 'tptr' and 'mptr', or NULL if the chain is full
+     */
+    template<typename T>
+    pFunctionPointer_t add(T *tptr, void (T::*mptr)(void)) {
+        pFunctionPointer_t pf = alloc();
+        if (pf != NULL) {
+            pf->attach(tptr, mptr);
+            link_after(_prev[N], pf - _chain);
+        }
+        return pf;
+    }
+
+    /** Add a function at the beginning of the chain
+     *
+     *  @param function A pointer to a void function
+     *
+     *  @returns
+     *  The function object for 'function', or NULL if the chain is full
+     */
+    pFunctionPointer_t add_front(void (*function)(void)) {
+        pFunctionPointer_t pf = alloc();
+        if (pf != NULL) {
+            pf->attach(function);
+            link_after(N, pf - _chain);
+        }
+        return pf;
+    }
+
+    /** Add a function at the beginning of the chain
+     *
+     *  @param tptr pointer to the object to call the member function on
+     *  @param mptr pointer to the member function to be called
+     *
+     *  @returns
+     *  The function object for 'tptr' and 'mptr', or NULL if the chain is full
+     */
+    template<typename T>
+    pFunctionPointer_t add_front(T *tptr, void (T::*mptr)(void)) {
+        pFunctionPointer_t pf = alloc();
+        if (pf != NULL) {
+            pf->attach(tptr, mptr);
+            link_after(N, pf - _chain);
+        }
+        return pf;
+    }
+
+    /** Get the number of functions in the chain
+     */
+    int size() const {
+        return _elements;
+    }
+
+    /** Get a function object from the chain
+     *
+     *  @param i function object index
+     *
+     *  @returns
+     *  The function object at position 'i' in the chain
+     */
+    pFunctionPointer_t get(int i) const {
+        if (i < 0 || i >= _elements)
+            return NULL;
+        int n = _next[N];
+        while (i--)
+            n = _next[n];
+        return const_cast<pFunctionPointer_t>(&_chain[n]);
+    }
+
+    /** Clear the call chain (remove all functions in the chain).
+     */
+    void clear() {
+        _next[N] = _prev[N] = N;
+        for (int i = 0; i < N; i++) {
+            _next[i] = i + 1;
+            _prev[i] = FREE;
+        }
+        _free = 0;
+        _elements = 0;
+    }
+
+    /** Remove a function object from the chain
+     *
+     *  @arg f the function object to remove
+     *
+     *  @returns
+     *  true if the function object was found and removed, false otherwise.
+     */
+    bool remove(pFunctionPointer_t f) {
+        int i = f - _chain;
+        if (i < 0 || i >= N || _prev[i] == FREE)
+            return false;
+        _next[_prev[i]] = _next[i];
+        _prev[_next[i]] = _prev[i];
+        _prev[i] = FREE;
+        _next[i] = _free;
+        _free = i;
+        _elements--;
+        return true;
+    }
+
+    /** Call all the functions in the chain in sequence
+     */
+    void call() {
+        int i = _next[N];
+        while (i != N) {
+            // a function may remove itself from the chain
+            int next = _next[i];
+            _chain[i].call();
+            i = next;
+        }
+    }
+
+#ifdef MBED_OPERATORS
+    void operator ()(void) {
+        call();
+    }
+    pFunctionPointer_t operator [](int i) const {
+        return get(i);
+    }
+#endif
+
+private:
+    static const unsigned char FREE = 0xFF;
+
+    pFunctionPointer_t alloc() {
+        if (_free == N)
+            return NULL;
+        pFunctionPointer_t pf = &_chain[_free];
+        _free = _next[_free];
+        _elements++;
+        return pf;
+    }
+
+    void link_after(int prev, int i) {
+        _next[i] = _next[prev];
+        _prev[i] = prev;
+        _prev[_next[prev]] = i;
+        _next[prev] = i;
+    }
+
+    FunctionPointer _chain[N];
+    // links of the chain, in call order; index N is the list head
+    unsigned char _next[N + 1];
+    unsigned char _prev[N + 1];
+    // first unused function object, linked through _next; N if the chain is full
+    unsigned char _free;
+    int _elements;
+};
+
+} // namespace mbed
+
+#endif
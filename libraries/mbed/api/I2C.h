@@ -22,8 +22,69 @@
 
 #include "i2c_api.h"
 
+#if DEVICE_I2C_ASYNCH
+#include "Callback.h"
+#endif
+
 namespace mbed {
 
+#if DEVICE_I2C_ASYNCH
+/** An I2C transaction, to be queued on an I2C master with I2C::transfer()
+ *
+ * A transaction writes some bytes to a slave, then, after a repeated start,
+ * reads some bytes back; either part can be empty. The transaction and its
+ * buffers are owned by the caller, and must not be changed while it is queued.
+ */
+class I2CTransaction {
+public:
+    /** Create a transaction
+     *
+     *  @param address 8-bit I2C slave address
+     *  @param tx The bytes to write, or NULL
+     *  @param tx_length The number of bytes to write
+     *  @param rx Buffer for the bytes to read, or NULL
+     *  @param rx_length The number of bytes to read
+     *  @param repeated Repeated start, true - keep the bus for the next transaction
+     */
+    I2CTransaction(int address = 0, const char *tx = NULL, int tx_length = 0,
+                   char *rx = NULL, int rx_length = 0, bool repeated = false) :
+        address(address), tx(tx), tx_length(tx_length),
+        rx(rx), rx_length(rx_length), repeated(repeated),
+        _result(0), _pending(false), _next(NULL) {
+    }
+
+    /** Check if the transaction is still queued or in progress
+     */
+    bool pending() const {
+        return _pending;
+    }
+
+    /** The result of the last completed run of the transaction
+     *
+     *  @returns
+     *    0 on success, or one of the (negative) I2C_ERROR_ codes
+     */
+    int result() const {
+        return _result;
+    }
+
+    int address;
+    const char *tx;
+    int tx_length;
+    char *rx;
+    int rx_length;
+    bool repeated;
+
+private:
+    friend class I2C;
+
+    Callback<void(int)> _done;
+    volatile int _result;
+    volatile bool _pending;
+    I2CTransaction *_next;
+};
+#endif
+
 /** An I2C Master, used for communicating with I2C slave devices
  *
  * Example:
@@ -129,12 +190,46 @@ public:
      */
     void stop(void);
 
+#if DEVICE_I2C_ASYNCH
+    /** Queue a transaction, to be run in the background
+     *
+     *  Transactions run one after the other, in the order they were queued,
+     *  driven by the I2C interrupt. When one is over, 'done' is called from
+     *  interrupt context with its result: 0 on success, or one of the
+     *  (negative) I2C_ERROR_ codes. A thread can wait for the transaction by
+     *  setting a signal from the callback.
+     *
+     *  The blocking functions must not be used while transactions are queued.
+     *
+     *  @param transaction The transaction to run
+     *  @param done Called when the transaction is over
+     *
+     *  @returns
+     *    0 if the transaction was queued, -1 if it is already queued
+     */
+    int transfer(I2CTransaction *transaction, Callback<void(int)> done = Callback<void(int)>());
+
+    /** Check if transactions are queued or in progress
+     */
+    bool busy() const {
+        return _head != NULL;
+    }
+#endif
+
 protected:
     void aquire();
 
     i2c_t _i2c;
     static I2C  *_owner;
     int         _hz;
+
+#if DEVICE_I2C_ASYNCH
+    void start_transfer();
+    static void _irq_handler(uint32_t id, int result);
+
+    I2CTransaction * volatile _head;
+    I2CTransaction *_tail;
+#endif
 };
 
 } // namespace mbed
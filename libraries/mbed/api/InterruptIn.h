@@ -23,6 +23,7 @@
 #include "gpio_api.h"
 #include "gpio_irq_api.h"
 #include "FunctionPointer.h"
+#include "Callback.h"
 
 namespace mbed {
 
@@ -85,6 +86,12 @@ public:
         gpio_irq_set(&gpio_irq, IRQ_RISE, 1);
     }
 
+    /** Attach a callback to call when a rising edge occurs on the input
+     *
+     *  @param func A callback, or an empty callback to set as none
+     */
+    void rise(Callback<void()> func);
+
     /** Attach a function to call when a falling edge occurs on the input
      *
      *  @param fptr A pointer to a void function, or 0 to set as none
@@ -102,6 +109,12 @@ public:
         gpio_irq_set(&gpio_irq, IRQ_FALL, 1);
     }
 
+    /** Attach a callback to call when a falling edge occurs on the input
+     *
+     *  @param func A callback, or an empty callback to set as none
+     */
+    void fall(Callback<void()> func);
+
     /** Set the input pin mode
      *
      *  @param mode PullUp, PullDown, PullNone
@@ -122,8 +135,8 @@ protected:
     gpio_t gpio;
     gpio_irq_t gpio_irq;
 
-    FunctionPointer _rise;
-    FunctionPointer _fall;
+    Callback<void()> _rise;
+    Callback<void()> _fall;
 };
 
 } // namespace mbed
@@ -0,0 +1,130 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_INTERRUPTINGROUP_H
+#define MBED_INTERRUPTINGROUP_H
+
+#include "platform.h"
+
+#if DEVICE_INTERRUPTIN_GROUP
+
+#include "port_api.h"
+#include "gpio_irq_api.h"
+#include "Callback.h"
+
+namespace mbed {
+
+/** A group of digital interrupt inputs on the same port, used to call a
+ *  single function with all the edges seen on the group
+ *
+ * The function is called once per interrupt with two bitmaps of the pins
+ * of the port that saw a rising and a falling edge, so bursts of edges on
+ * many pins are handled in one call.
+ *
+ * Example:
+ * @code
+ * // Count pulses on mbed pins 21-26
+ *
+ * #include "mbed.h"
+ *
+ * InterruptInGroup pulses(Port2, 0x0000003F);   // p21-p26
+ * volatile int count[32];
+ *
+ * void edges(int rise, int fall) {
+ *     while (rise) {
+ *         int bit = 31 - __CLZ(rise);
+ *         count[bit]++;
+ *         rise &= ~(1 << bit);
+ *     }
+ * }
+ *
+ * int main() {
+ *     pulses.attach(&edges);
+ *     pulses.fall(false);
+ *     while(1);
+ * }
+ * @endcode
+ */
+class InterruptInGroup {
+
+public:
+
+    /** Create an InterruptInGroup connected to the specified pins of a port
+     *
+     *  @param port Port to connect to
+     *  @param mask A bitmask to identify which pins of the port are in the group
+     *  @param dir  The direction to set the pins to; PIN_OUTPUT to see the
+     *              edges the program drives on the pins itself (defaults to PIN_INPUT)
+     */
+    InterruptInGroup(PortName port, int mask, PinDirection dir = PIN_INPUT);
+    virtual ~InterruptInGroup();
+
+    /** Read the current value of the pins in the group
+     */
+    int read();
+
+    /** Attach a function to call with the rising and falling edge bitmaps
+     *  of the group; edges on both directions are enabled
+     *
+     *  @param fptr A pointer to a void function, or 0 to set as none
+     */
+    void attach(void (*fptr)(int rise, int fall));
+
+    /** Attach a member function to call with the rising and falling edge
+     *  bitmaps of the group; edges on both directions are enabled
+     *
+     *  @param tptr pointer to the object to call the member function on
+     *  @param mptr pointer to the member function to be called
+     */
+    template<typename T>
+    void attach(T* tptr, void (T::*mptr)(int rise, int fall)) {
+        attach(Callback<void(int, int)>(tptr, mptr));
+    }
+
+    /** Attach a callback to call with the rising and falling edge bitmaps
+     *  of the group; edges on both directions are enabled
+     *
+     *  @param func A callback, or an empty callback to set as none
+     */
+    void attach(Callback<void(int, int)> func);
+
+    /** Enable or disable the rising edge interrupts of the group
+     */
+    void rise(bool enable);
+
+    /** Enable or disable the falling edge interrupts of the group
+     */
+    void fall(bool enable);
+
+    /** Set the input pin mode
+     *
+     *  @param mode PullUp, PullDown, PullNone
+     */
+    void mode(PinMode pull);
+
+    static void _irq_handler(uint32_t id, uint32_t rise, uint32_t fall);
+
+protected:
+    port_t _port;
+    gpio_irq_group_t _group;
+
+    Callback<void(int, int)> _function;
+};
+
+} // namespace mbed
+
+#endif
+
+#endif
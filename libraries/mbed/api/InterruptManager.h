@@ -2,9 +2,28 @@
 #define MBED_INTERRUPTMANAGER_H
 
 #include "cmsis.h"
-#include "CallChain.h"
+#include "FixedCallChain.h"
 #include <string.h>
 
+/* Maximum number of handlers chained on a single interrupt, including the
+   handler that was installed in the vector table before chaining started */
+#ifndef INTERRUPT_CHAIN_SIZE
+#define INTERRUPT_CHAIN_SIZE    8
+#endif
+
+/* Number of interrupt vectors that can be chained at the same time: the
+   chains are taken from a static pool of this size, not from the heap */
+#ifndef INTERRUPT_CHAIN_COUNT
+#define INTERRUPT_CHAIN_COUNT   4
+#endif
+
+/* When set, each chained interrupt vector points to its own small
+   trampoline that calls the chain for that vector directly, instead of a
+   common handler that looks up the chain through the active IPSR value */
+#ifndef INTERRUPT_DIRECT_DISPATCH
+#define INTERRUPT_DIRECT_DISPATCH   1
+#endif
+
 namespace mbed {
 
 /** Use this singleton if you need to chain interrupt handlers.
@@ -49,7 +68,8 @@ public:
      *  @param irq interrupt number
      *
      *  @returns
-     *  The function object created for 'function'
+     *  The function object created for 'function', or NULL if the chain is full
+     *  or no chain is left for the interrupt
      */
     pFunctionPointer_t add_handler(void (*function)(void), IRQn_Type irq) {
         return add_common(function, irq);
@@ -61,7 +81,8 @@ public:
      *  @param irq interrupt number
      *
      *  @returns
-     *  The function object created for 'function'
+     *  The function object created for 'function', or NULL if the chain is full
+     *  or no chain is left for the interrupt
      */
     pFunctionPointer_t add_handler_front(void (*function)(void), IRQn_Type irq) {
         return add_common(function, irq, true);
@@ -74,7 +95,8 @@ public:
      *  @param irq interrupt number
      *
      *  @returns
-     *  The function object created for 'tptr' and 'mptr'
+     *  The function object created for 'tptr' and 'mptr', or NULL if the chain is full
+     *  or no chain is left for the interrupt
      */
     template<typename T>
     pFunctionPointer_t add_handler(T* tptr, void (T::*mptr)(void), IRQn_Type irq) {
@@ -88,7 +110,8 @@ public:
      *  @param irq interrupt number
      *
      *  @returns
-     *  The function object created for 'tptr' and 'mptr'
+     *  The function object created for 'tptr' and 'mptr', or NULL if the chain is full
+     *  or no chain is left for the interrupt
      */
     template<typename T>
     pFunctionPointer_t add_handler_front(T* tptr, void (T::*mptr)(void), IRQn_Type irq) {
@@ -119,10 +142,12 @@ private:
     pFunctionPointer_t add_common(T *tptr, void (T::*mptr)(void), IRQn_Type irq, bool front=false) {
         int irq_pos = get_irq_index(irq);
         bool change = must_replace_vector(irq);
+        if (NULL == _chains[irq_pos])
+            return NULL;
 
         pFunctionPointer_t pf = front ? _chains[irq_pos]->add_front(tptr, mptr) : _chains[irq_pos]->add(tptr, mptr);
         if (change)
-            NVIC_SetVector(irq, (uint32_t)&InterruptManager::static_irq_helper);
+            NVIC_SetVector(irq, (uint32_t)get_dispatcher(irq_pos));
         return pf;
     }
 
@@ -132,8 +157,22 @@ private:
     void irq_helper();
     void add_helper(void (*function)(void), IRQn_Type irq, bool front=false);
     static void static_irq_helper();
+    static pvoidf_t get_dispatcher(int irq_pos);
+#if INTERRUPT_DIRECT_DISPATCH
+    template<int I>
+    static void irq_thunk();
+    template<int FIRST, int COUNT>
+    struct ThunkTable;
+#endif
+
+    typedef FixedCallChain<INTERRUPT_CHAIN_SIZE> InterruptChain;
+
+    static InterruptChain* chain_pool();
+    static InterruptChain* alloc_chain();
+    static void free_chain(InterruptChain *chain);
 
-    CallChain* _chains[NVIC_NUM_VECTORS];
+    static InterruptChain* _chains[NVIC_NUM_VECTORS];
+    static bool _chain_used[INTERRUPT_CHAIN_COUNT];
     static InterruptManager* _instance;
 };
 
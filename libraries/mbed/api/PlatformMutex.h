@@ -0,0 +1,59 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PLATFORMMUTEX_H
+#define MBED_PLATFORMMUTEX_H
+
+#include <stdint.h>
+
+/* Set to 0 to leave out the locks of the file, file system and console layers */
+#ifndef MBED_THREAD_SAFE
+#define MBED_THREAD_SAFE    1
+#endif
+
+namespace mbed {
+
+/** A recursive mutex for the shared state of the library
+ *
+ * It is an RTX mutex when the program uses the rtos library, and does
+ * nothing otherwise: the library cannot depend on the rtos, so it calls the
+ * CMSIS-RTOS functions through weak references, which are NULL unless the
+ * RTOS is linked. The RTX mutex is created the first time it is locked.
+ *
+ * Locking does nothing until the kernel is started, and in interrupt
+ * handlers, which cannot wait for a mutex.
+ */
+class PlatformMutex {
+public:
+    PlatformMutex();
+    ~PlatformMutex();
+
+    void lock();
+    void unlock();
+
+#if MBED_THREAD_SAFE
+private:
+    void create();
+
+    void *_id;              // osMutexId
+    void *_def;             // osMutexDef_t: the address of _data
+    uint32_t _data[3];      // RTX mutex control block
+    volatile uint8_t _state;
+#endif
+};
+
+} // namespace mbed
+
+#endif
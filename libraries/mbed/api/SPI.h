@@ -21,6 +21,7 @@
 #if DEVICE_SPI
 
 #include "spi_api.h"
+#include "Callback.h"
 
 namespace mbed {
 
@@ -92,6 +93,27 @@ public:
     */
     virtual int write(int value);
 
+#if DEVICE_SPI_BLOCK
+    /** Exchange a block of frames with the SPI Slave
+     *
+     *  Frames are one byte each for formats of up to 8 bits, and two bytes
+     *  (halfword aligned) otherwise.
+     *
+     *  Without a callback the transfer is blocking, and keeps the SPI FIFO
+     *  full instead of waiting for each frame. With a callback the function
+     *  may return before the transfer has finished, on targets which can
+     *  transfer in the background; the buffers must stay valid, and the SPI
+     *  unused, until 'done' has been called (from interrupt context). A new
+     *  transfer waits for a background transfer on the same SPI to finish.
+     *
+     *  @param tx The frames to send, or NULL to send all ones
+     *  @param rx Buffer for the frames received, or NULL to discard them
+     *  @param length The number of frames to exchange
+     *  @param done Called when the transfer has finished
+     */
+    void transfer(const void *tx, void *rx, size_t length, Callback<void()> done = Callback<void()>());
+#endif
+
 protected:
     spi_t _spi;
 
@@ -100,6 +122,11 @@ protected:
     int _bits;
     int _mode;
     int _hz;
+
+#if DEVICE_SPI_DMA
+    static void _dma_handler(uint32_t id);
+    Callback<void()> _done;
+#endif
 };
 
 } // namespace mbed
@@ -59,7 +59,8 @@ public:
 
 protected:
     virtual int _getc();
-    virtual int _putc(int c);    
+    virtual int _putc(int c);
+    virtual int _readable();
 };
 
 } // namespace mbed
@@ -22,6 +22,7 @@
 
 #include "Stream.h"
 #include "FunctionPointer.h"
+#include "Callback.h"
 #include "serial_api.h"
 
 namespace mbed {
@@ -96,6 +97,13 @@ public:
         }
     }
 
+    /** Attach a callback to call whenever a serial interrupt is generated
+     *
+     *  @param func A callback, or an empty callback to set as none
+     *  @param type Which serial interrupt to attach the callback to (Seriall::RxIrq for receive, TxIrq for transmit buffer empty)
+     */
+    void attach(Callback<void()> func, IrqType type=RxIrq);
+
     /** Generate a break condition on the serial line
      */
     void send_break();
@@ -109,7 +117,7 @@ protected:
     int _base_putc(int c);
 
     serial_t        _serial;
-    FunctionPointer _irq[2];
+    Callback<void()> _irq[2];
     int             _baud;
 };
 
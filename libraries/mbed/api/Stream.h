@@ -18,9 +18,33 @@
 
 #include "platform.h"
 #include "FileLike.h"
+#include "PlatformMutex.h"
+
+/* Size of the stack buffer printf() formats into. Longer output is
+ * formatted through the stdio FILE instead, one write() per character. */
+#ifndef STREAM_PRINTF_BUFFER
+#define STREAM_PRINTF_BUFFER    128
+#endif
+
+/* Set to 1 to format printf() with mbed_printf instead of the C library,
+ * which saves the flash of the C library printf when nothing else uses it.
+ * Output of any length is then sent in pieces of STREAM_PRINTF_BUFFER. */
+#ifndef STREAM_MBED_PRINTF
+#define STREAM_MBED_PRINTF      0
+#endif
 
 namespace mbed {
 
+/** A FileLike with stdio style functions
+ *
+ * Output does not go through the stdio FILE: putc() and puts() go straight
+ * to _putc() and write(), and printf() formats into a buffer on the stack
+ * and hands it to write() at once. Derived classes which can send a block
+ * faster than character by character should override write().
+ *
+ * puts() and printf() lock the stream, so that lines printed by different
+ * threads are not mixed.
+ */
 class Stream : public FileLike {
 
 public:
@@ -48,7 +72,15 @@ protected:
     virtual int _putc(int c) = 0;
     virtual int _getc() = 0;
 
+    /* Whether _getc() has a character ready: read() returns early, with
+     * what it has, rather than wait for the next character. The default
+     * makes read() return one character at a time. */
+    virtual int _readable() {
+        return 0;
+    }
+
     std::FILE *_file;
+    PlatformMutex _mutex;
 };
 
 } // namespace mbed
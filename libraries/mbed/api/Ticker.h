@@ -18,6 +18,7 @@
 
 #include "TimerEvent.h"
 #include "FunctionPointer.h"
+#include "Callback.h"
 
 namespace mbed {
 
@@ -64,7 +65,8 @@ public:
      *  @param t the time between calls in seconds
      */
     void attach(void (*fptr)(void), float t) {
-        attach_us(fptr, t * 1000000.0f);
+        _function.attach(fptr);
+        setup(t * 1000000.0f);
     }
 
     /** Attach a member function to be called by the Ticker, specifiying the interval in seconds
@@ -75,7 +77,18 @@ public:
      */
     template<typename T>
     void attach(T* tptr, void (T::*mptr)(void), float t) {
-        attach_us(tptr, mptr, t * 1000000.0f);
+        _function.attach(tptr, mptr);
+        setup(t * 1000000.0f);
+    }
+
+    /** Attach a callback to be called by the Ticker, specifiying the interval in seconds
+     *
+     *  @param func the callback to be called
+     *  @param t the time between calls in seconds
+     */
+    void attach(Callback<void()> func, float t) {
+        _function = func;
+        setup(t * 1000000.0f);
     }
 
     /** Attach a function to be called by the Ticker, specifiying the interval in micro-seconds
@@ -100,16 +113,26 @@ public:
         setup(t);
     }
 
+    /** Attach a callback to be called by the Ticker, specifiying the interval in micro-seconds
+     *
+     *  @param func the callback to be called
+     *  @param t the time between calls in micro-seconds
+     */
+    void attach_us(Callback<void()> func, unsigned int t) {
+        _function = func;
+        setup(t);
+    }
+
     /** Detach the function
      */
     void detach();
 
 protected:
-    void setup(unsigned int t);
+    void setup(us_timestamp_t t);
     virtual void handler();
 
-    unsigned int _delay;
-    FunctionPointer _function;
+    us_timestamp_t _delay;
+    Callback<void()> _function;
 };
 
 } // namespace mbed
@@ -17,6 +17,7 @@
 #define MBED_TIMER_H
 
 #include "platform.h"
+#include "us_ticker_api.h"
 
 namespace mbed {
 
@@ -72,15 +73,21 @@ public:
      */
     int read_us();
 
+    /** Get the time passed in micro-seconds on the 64-bit time base
+     *
+     *  Unlike read_us(), this does not wrap after ~35 minutes
+     */
+    us_timestamp_t read_high_resolution_us();
+
 #ifdef MBED_OPERATORS
     operator float();
 #endif
 
 protected:
-    int slicetime();
+    us_timestamp_t slicetime();
     int _running;          // whether the timer is running
-    unsigned int _start;   // the start time of the latest slice
-    int _time;             // any accumulated time from previous slices
+    us_timestamp_t _start; // the start time of the latest slice
+    us_timestamp_t _time;  // any accumulated time from previous slices
 };
 
 } // namespace mbed
@@ -38,10 +38,13 @@ protected:
     // The handler called to service the timer event of the derived class
     virtual void handler() = 0;
 
-    // insert in to linked list
+    // insert in to the event queue
     void insert(unsigned int timestamp);
 
-    // remove from linked list, if in it
+    // insert in to the event queue, with a deadline on the 64-bit time base
+    void insert_absolute(us_timestamp_t timestamp);
+
+    // remove from the event queue, if in it
     void remove();
 
     ticker_event_t event;
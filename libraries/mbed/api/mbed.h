@@ -27,6 +27,7 @@
 // mbed Debug libraries
 #include "error.h"
 #include "mbed_interface.h"
+#include "mbed_printf.h"
 
 // mbed Peripheral components
 #include "DigitalIn.h"
@@ -49,6 +50,7 @@
 #include "Ethernet.h"
 #include "CAN.h"
 #include "RawSerial.h"
+#include "BufferedSerial.h"
 
 // mbed Internal components
 #include "Timer.h"
@@ -56,6 +58,7 @@
 #include "Timeout.h"
 #include "LocalFileSystem.h"
 #include "InterruptIn.h"
+#include "InterruptInGroup.h"
 #include "wait_api.h"
 #include "sleep_api.h"
 #include "rtc_time.h"
@@ -0,0 +1,205 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_PRINTF_H
+#define MBED_PRINTF_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+/* Set to 0 to leave out %f, %e and %g, and the floating point code with them */
+#ifndef MBED_PRINTF_FLOAT
+#define MBED_PRINTF_FLOAT       1
+#endif
+
+/* Maximum number of conversions a PrintfFormat keeps pre-parsed */
+#ifndef MBED_PRINTF_MAX_SPECS
+#define MBED_PRINTF_MAX_SPECS   8
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A small printf, independent of the C library stdio
+ *
+ * Supports the conversions d i u o x X c s p % and, unless MBED_PRINTF_FLOAT
+ * is 0, f F e E g G; the flags - + space 0 #, width and precision (also as *),
+ * and the length modifiers hh h l ll z j t. Floating point values are
+ * converted exactly with integer arithmetic, rounding half to even, with at
+ * most 40 digits of precision; this takes about 800 bytes of stack.
+ *
+ * mbed_printf() writes to the console (see set_console()) in pieces of at
+ * most 64 characters, without going through the stdout FILE.
+ */
+int mbed_printf(const char *format, ...);
+int mbed_vprintf(const char *format, va_list arg);
+int mbed_snprintf(char *buffer, size_t size, const char *format, ...);
+int mbed_vsnprintf(char *buffer, size_t size, const char *format, va_list arg);
+
+/* The formatter itself: sends the output to out(context, data, length) in
+ * pieces, and returns the number of characters formatted */
+typedef void (*mbed_printf_out)(void *context, const char *data, size_t length);
+int mbed_vxprintf(mbed_printf_out out, void *context, const char *format, va_list arg);
+
+/* Write to stdout, or the console set with set_console(), directly */
+int mbed_console_write(const char *data, size_t length);
+
+#ifdef __cplusplus
+}
+
+namespace mbed {
+
+/** An argument of PrintfFormat, converted from the C++ type of the value
+ */
+class PrintfArg {
+public:
+    enum Kind {
+        Signed,
+        Unsigned,
+        Float,
+        Pointer
+    };
+
+    PrintfArg(int v)                : kind(Signed)   {value.i = v;}
+    PrintfArg(long v)               : kind(Signed)   {value.i = v;}
+    PrintfArg(long long v)          : kind(Signed)   {value.i = v;}
+    PrintfArg(unsigned int v)       : kind(Unsigned) {value.u = v;}
+    PrintfArg(unsigned long v)      : kind(Unsigned) {value.u = v;}
+    PrintfArg(unsigned long long v) : kind(Unsigned) {value.u = v;}
+    PrintfArg(double v)             : kind(Float)    {value.d = v;}
+    PrintfArg(const char *v)        : kind(Pointer)  {value.p = v;}
+    PrintfArg(const void *v)        : kind(Pointer)  {value.p = v;}
+
+    Kind kind;
+    union {
+        long long i;
+        unsigned long long u;
+        double d;
+        const void *p;
+    } value;
+};
+
+/** A printf format string, parsed once for repeated use
+ *
+ * Parsing the format is a noticeable part of formatting short messages.
+ * A PrintfFormat parses its format when it is constructed, so that a hot
+ * log statement only converts its arguments. The arguments are passed as
+ * PrintfArg, so their types are known at compile time rather than assumed
+ * from the format:
+ *
+ * @code
+ * void log_sample(int channel, float value) {
+ *     static const PrintfFormat fmt("ch%d=%.3f\r\n");
+ *     fmt.printf(channel, value);
+ * }
+ * @endcode
+ *
+ * Formats with more than MBED_PRINTF_MAX_SPECS conversions are parsed at
+ * every use instead. The format string must outlive the PrintfFormat.
+ */
+class PrintfFormat {
+public:
+    PrintfFormat(const char *format);
+
+    /** Format the arguments to the console, as mbed_printf()
+     */
+    int printf() const {
+        return print(NULL, 0);
+    }
+    int printf(PrintfArg a0) const {
+        PrintfArg args[] = {a0};
+        return print(args, 1);
+    }
+    int printf(PrintfArg a0, PrintfArg a1) const {
+        PrintfArg args[] = {a0, a1};
+        return print(args, 2);
+    }
+    int printf(PrintfArg a0, PrintfArg a1, PrintfArg a2) const {
+        PrintfArg args[] = {a0, a1, a2};
+        return print(args, 3);
+    }
+    int printf(PrintfArg a0, PrintfArg a1, PrintfArg a2, PrintfArg a3) const {
+        PrintfArg args[] = {a0, a1, a2, a3};
+        return print(args, 4);
+    }
+    int printf(PrintfArg a0, PrintfArg a1, PrintfArg a2, PrintfArg a3, PrintfArg a4) const {
+        PrintfArg args[] = {a0, a1, a2, a3, a4};
+        return print(args, 5);
+    }
+    int printf(PrintfArg a0, PrintfArg a1, PrintfArg a2, PrintfArg a3, PrintfArg a4, PrintfArg a5) const {
+        PrintfArg args[] = {a0, a1, a2, a3, a4, a5};
+        return print(args, 6);
+    }
+
+    /** Format the arguments into a buffer, as mbed_snprintf()
+     */
+    int snprintf(char *buffer, size_t size) const {
+        return sprint(buffer, size, NULL, 0);
+    }
+    int snprintf(char *buffer, size_t size, PrintfArg a0) const {
+        PrintfArg args[] = {a0};
+        return sprint(buffer, size, args, 1);
+    }
+    int snprintf(char *buffer, size_t size, PrintfArg a0, PrintfArg a1) const {
+        PrintfArg args[] = {a0, a1};
+        return sprint(buffer, size, args, 2);
+    }
+    int snprintf(char *buffer, size_t size, PrintfArg a0, PrintfArg a1, PrintfArg a2) const {
+        PrintfArg args[] = {a0, a1, a2};
+        return sprint(buffer, size, args, 3);
+    }
+    int snprintf(char *buffer, size_t size, PrintfArg a0, PrintfArg a1, PrintfArg a2, PrintfArg a3) const {
+        PrintfArg args[] = {a0, a1, a2, a3};
+        return sprint(buffer, size, args, 4);
+    }
+    int snprintf(char *buffer, size_t size, PrintfArg a0, PrintfArg a1, PrintfArg a2, PrintfArg a3, PrintfArg a4) const {
+        PrintfArg args[] = {a0, a1, a2, a3, a4};
+        return sprint(buffer, size, args, 5);
+    }
+    int snprintf(char *buffer, size_t size, PrintfArg a0, PrintfArg a1, PrintfArg a2, PrintfArg a3, PrintfArg a4, PrintfArg a5) const {
+        PrintfArg args[] = {a0, a1, a2, a3, a4, a5};
+        return sprint(buffer, size, args, 6);
+    }
+
+    /** Format an array of arguments, sending the output to out()
+     *
+     *  Missing arguments are formatted as 0.
+     */
+    int format(mbed_printf_out out, void *context, const PrintfArg *args, int count) const;
+
+    struct Spec {
+        unsigned short start;   // offset of the '%' in the format
+        unsigned short end;     // offset just after the conversion character
+        unsigned char flags;
+        char length;
+        char conversion;
+        int width;              // -1 if none, -2 if given by an argument
+        int precision;          // -1 if none, -2 if given by an argument
+    };
+
+private:
+    int print(const PrintfArg *args, int count) const;
+    int sprint(char *buffer, size_t size, const PrintfArg *args, int count) const;
+
+    const char *_format;
+    Spec _specs[MBED_PRINTF_MAX_SPECS];
+    int _count;                 // number of specs, or -1 if they did not fit
+};
+
+} // namespace mbed
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_TRACE_H
+#define MBED_TRACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+/* Size of the trace ring in 32-bit words; must be a power of 2 */
+#ifndef MBED_TRACE_BUFFER
+#define MBED_TRACE_BUFFER   1024
+#endif
+
+/* Record layout, in 32-bit words:
+ *   header:  bit 31 set, bits 30-27 number of arguments, bits 26-0 time in us
+ *   format:  address of the format string, or 0 for a count of lost records
+ *   arguments
+ */
+#define MBED_TRACE_VALID        0x80000000UL
+#define MBED_TRACE_ARGS_SHIFT   27
+#define MBED_TRACE_TIME_MASK    0x07FFFFFFUL
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Binary tracing, cheap enough for interrupt handlers
+ *
+ * A trace record is the address of its format string and its raw 32-bit
+ * arguments, stored into a RAM ring with a timestamp; the formatting is done
+ * on the host by workspace_tools/trace.py, which looks the format strings up
+ * in the ELF file of the program. Recording an event takes a few stores.
+ *
+ * The ring can be written from any context at once, without locks, and is
+ * read by a single consumer with mbed_trace_read() or trace_drain(). Records
+ * which do not fit are dropped, and their number is reported in the stream.
+ *
+ * The format must be a string literal. Arguments are integers or pointers;
+ * %s prints constant strings of the program, and %f a float passed through
+ * mbed_trace_float().
+ *
+ * @code
+ * void adc_irq() {
+ *     mbed_trace2("adc ch%d=%u", channel, value);
+ * }
+ * @endcode
+ */
+void mbed_trace0(const char *format);
+void mbed_trace1(const char *format, uint32_t a0);
+void mbed_trace2(const char *format, uint32_t a0, uint32_t a1);
+void mbed_trace3(const char *format, uint32_t a0, uint32_t a1, uint32_t a2);
+void mbed_trace4(const char *format, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+/** Copy whole records out of the ring
+ *
+ *  @param buffer Buffer for the records
+ *  @param size Size of the buffer in words
+ *
+ *  @returns
+ *    The number of words copied, 0 if the ring is empty
+ */
+int mbed_trace_read(uint32_t *buffer, int size);
+
+/* The bits of a float, to pass it as an argument */
+static inline uint32_t mbed_trace_float(float f) {
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+#ifdef __cplusplus
+}
+
+namespace mbed {
+
+class FileHandle;
+
+/** Send the records in the trace ring to a file, such as a Serial or USBSerial
+ *
+ *  Call it from a low priority thread or the main loop, not from an interrupt:
+ *
+ *  @code
+ *  void drain_thread(void const *arg) {
+ *      while (true) {
+ *          if (trace_drain(&usb) == 0)
+ *              Thread::wait(1);
+ *      }
+ *  }
+ *  @endcode
+ *
+ *  The ring absorbs bursts; the sustained rate is limited by the link.
+ *
+ *  @returns
+ *    The number of words sent
+ */
+int trace_drain(FileHandle *out);
+
+} // namespace mbed
+#endif
+
+#endif
@@ -0,0 +1,218 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BufferedSerial.h"
+#include "us_ticker_api.h"
+#include "toolchain.h"
+#include "cmsis.h"
+#include <string.h>
+
+#if DEVICE_SERIAL
+
+// Resolved to the RTX function when the RTOS is linked, NULL otherwise
+extern "C" int32_t osDelay(uint32_t millisec) WEAK;
+
+namespace mbed {
+
+// One slot of each buffer is kept free, to tell a full buffer from an empty one
+BufferedSerial::BufferedSerial(PinName tx, PinName rx, int tx_size, int rx_size) : SerialBase(tx, rx) {
+    _tx_size = tx_size + 1;
+    _tx_buf = new char[_tx_size];
+    _tx_head = _tx_tail = 0;
+
+    _rx_size = rx_size + 1;
+    _rx_buf = new char[_rx_size];
+    _rx_head = _rx_tail = 0;
+
+    _rx_overruns = 0;
+    _timeout = -1;
+
+    // the transmit interrupt is only enabled while there is data to send
+    _irq[TxIrq].attach(this, &BufferedSerial::tx_irq);
+    attach(this, &BufferedSerial::rx_irq, RxIrq);
+}
+
+BufferedSerial::~BufferedSerial() {
+    serial_irq_set(&_serial, (SerialIrq)RxIrq, 0);
+    serial_irq_set(&_serial, (SerialIrq)TxIrq, 0);
+    delete [] _tx_buf;
+    delete [] _rx_buf;
+}
+
+int BufferedSerial::putc(int c) {
+    char ch = c;
+    return (write(&ch, 1) == 1) ? c : -1;
+}
+
+int BufferedSerial::getc() {
+    char ch;
+    return (read(&ch, 1) == 1) ? (unsigned char)ch : -1;
+}
+
+ssize_t BufferedSerial::write(const void *buffer, size_t length) {
+    const char *data = (const char *)buffer;
+    us_timestamp_t start = us_ticker_read64();
+    ssize_t written = 0;
+
+    while (written < (ssize_t)length) {
+        int head = _tx_head;
+        int tail = _tx_tail;
+        // contiguous free space from head
+        int n = (tail > head) ? (tail - head - 1) : (_tx_size - head - (tail == 0 ? 1 : 0));
+        if (n == 0) {
+            tx_start();
+            if (!wait(start))
+                break;
+            continue;
+        }
+        if (n > (ssize_t)length - written)
+            n = length - written;
+
+        memcpy(_tx_buf + head, data + written, n);
+        head += n;
+        if (head == _tx_size)
+            head = 0;
+        __DMB();
+        _tx_head = head;
+        written += n;
+    }
+
+    tx_start();
+    return written;
+}
+
+ssize_t BufferedSerial::read(void *buffer, size_t length) {
+    char *data = (char *)buffer;
+    us_timestamp_t start = us_ticker_read64();
+    ssize_t count = 0;
+
+    while (count < (ssize_t)length) {
+        int head = _rx_head;
+        int tail = _rx_tail;
+        // contiguous data from tail
+        int n = (head >= tail) ? (head - tail) : (_rx_size - tail);
+        if (n == 0) {
+            if (!wait(start))
+                break;
+            continue;
+        }
+        if (n > (ssize_t)length - count)
+            n = length - count;
+
+        __DMB();
+        memcpy(data + count, _rx_buf + tail, n);
+        tail += n;
+        if (tail == _rx_size)
+            tail = 0;
+        __DMB();
+        _rx_tail = tail;
+        count += n;
+    }
+
+    return count;
+}
+
+int BufferedSerial::readable() {
+    int n = _rx_head - _rx_tail;
+    return (n < 0) ? n + _rx_size : n;
+}
+
+int BufferedSerial::writeable() {
+    int n = _tx_head - _tx_tail;
+    return _tx_size - 1 - ((n < 0) ? n + _tx_size : n);
+}
+
+void BufferedSerial::set_timeout(int ms) {
+    _timeout = ms;
+}
+
+int BufferedSerial::fsync() {
+    us_timestamp_t start = us_ticker_read64();
+    while (_tx_tail != _tx_head) {
+        if (!wait(start))
+            return -1;
+    }
+    return 0;
+}
+
+int BufferedSerial::close() {
+    return 0;
+}
+
+int BufferedSerial::isatty() {
+    return 1;
+}
+
+off_t BufferedSerial::lseek(off_t offset, int whence) {
+    return -1;
+}
+
+// Called when the receive FIFO reaches its trigger level: empty it
+void BufferedSerial::rx_irq() {
+    while (serial_readable(&_serial)) {
+        char c = serial_getc(&_serial);
+        int head = _rx_head;
+        int next = (head + 1 == _rx_size) ? 0 : head + 1;
+        if (next == _rx_tail) {
+            _rx_overruns++;
+        } else {
+            _rx_buf[head] = c;
+            __DMB();
+            _rx_head = next;
+        }
+    }
+}
+
+// Called when the transmit FIFO is empty: fill it
+void BufferedSerial::tx_irq() {
+    int tail = _tx_tail;
+    int head = _tx_head;
+    while (tail != head && serial_writable(&_serial)) {
+        serial_putc(&_serial, _tx_buf[tail]);
+        tail = (tail + 1 == _tx_size) ? 0 : tail + 1;
+    }
+    _tx_tail = tail;
+    serial_irq_set(&_serial, (SerialIrq)TxIrq, (tail != head) ? 1 : 0);
+}
+
+// Fill the transmit FIFO from the application side. The transmit interrupt
+// is masked meanwhile, so that there is still a single consumer.
+void BufferedSerial::tx_start() {
+#ifdef __CORTEX_M
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    tx_irq();
+    __set_PRIMASK(primask);
+#else
+    __disable_irq();
+    tx_irq();
+    __enable_irq();
+#endif
+}
+
+// Wait a little for the buffers to change; false once the timeout expired
+bool BufferedSerial::wait(us_timestamp_t start) {
+    if (_timeout == 0)
+        return false;
+    if (_timeout > 0 && (us_ticker_read64() - start) >= (us_timestamp_t)_timeout * 1000)
+        return false;
+    if (osDelay != NULL)
+        osDelay(1);
+    return true;
+}
+
+} // namespace mbed
+
+#endif
@@ -0,0 +1,191 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BusPorts.h"
+
+namespace mbed {
+
+#if DEVICE_PORT_PINMAP
+
+BusPorts::BusPorts() : _groups(NULL), _ngroups(0) {
+}
+
+void BusPorts::init(PinName pins[16], PinDirection dir) {
+    PortName ports[16];
+    uint32_t port_masks[16];
+    uint16_t bus_masks[16];
+
+    for (int i=0; i<16; i++) {
+        PortName port;
+        int bit = (pins[i] != NC) ? pin_port(pins[i], &port) : -1;
+        if (bit < 0)
+            continue;
+
+        int g = 0;
+        while (g < _ngroups && ports[g] != port)
+            g++;
+        if (g == _ngroups) {
+            ports[g] = port;
+            port_masks[g] = 0;
+            bus_masks[g] = 0;
+            _ngroups++;
+        }
+        port_masks[g] |= 1UL << bit;
+        bus_masks[g] |= 1 << i;
+        _port_bit[i] = bit;
+    }
+
+    if (_ngroups == 0)
+        return;
+
+    _groups = new Group[_ngroups];
+    for (int g=0; g<_ngroups; g++) {
+        Group &group = _groups[g];
+        port_init(&group.port, ports[g], port_masks[g], dir);
+        // the pulls gpio_init() sets on each pin
+        port_mode(&group.port, (dir == PIN_INPUT) ? PullDown : PullNone);
+        group.bus_mask = bus_masks[g];
+        group.linear = true;
+        group.shift = 0;
+
+        bool first = true;
+        for (int i=0; i<16; i++) {
+            if (!(group.bus_mask & (1 << i)))
+                continue;
+            int shift = _port_bit[i] - i;
+            if (first) {
+                group.shift = shift;
+                first = false;
+            } else if (shift != group.shift) {
+                group.linear = false;
+                break;
+            }
+        }
+    }
+}
+
+BusPorts::~BusPorts() {
+    delete [] _groups;
+}
+
+void BusPorts::write(int value) {
+    for (int g=0; g<_ngroups; g++) {
+        Group &group = _groups[g];
+        uint32_t bits = value & group.bus_mask;
+        uint32_t v = 0;
+        if (group.linear) {
+            v = (group.shift >= 0) ? bits << group.shift : bits >> -group.shift;
+        } else {
+            for (int i=0; bits; i++, bits >>= 1) {
+                if (bits & 1)
+                    v |= 1UL << _port_bit[i];
+            }
+        }
+        port_write(&group.port, v);
+    }
+}
+
+int BusPorts::read() {
+    int value = 0;
+    for (int g=0; g<_ngroups; g++) {
+        Group &group = _groups[g];
+        uint32_t v = port_read(&group.port);
+        if (group.linear) {
+            v = (group.shift >= 0) ? v >> group.shift : v << -group.shift;
+            value |= v & group.bus_mask;
+        } else {
+            for (int i=0; i<16; i++) {
+                if ((group.bus_mask & (1 << i)) && (v & (1UL << _port_bit[i])))
+                    value |= 1 << i;
+            }
+        }
+    }
+    return value;
+}
+
+void BusPorts::dir(PinDirection dir) {
+    for (int g=0; g<_ngroups; g++) {
+        port_dir(&_groups[g].port, dir);
+    }
+}
+
+void BusPorts::mode(PinMode pull) {
+    for (int g=0; g<_ngroups; g++) {
+        port_mode(&_groups[g].port, pull);
+    }
+}
+
+#else
+
+BusPorts::BusPorts() {
+    for (int i=0; i<16; i++) {
+        _pin[i] = 0;
+    }
+}
+
+void BusPorts::init(PinName pins[16], PinDirection dir) {
+    for (int i=0; i<16; i++) {
+        if (pins[i] != NC) {
+            _pin[i] = new gpio_t;
+            gpio_init(_pin[i], pins[i], dir);
+        }
+    }
+}
+
+BusPorts::~BusPorts() {
+    for (int i=0; i<16; i++) {
+        if (_pin[i] != 0) {
+            delete _pin[i];
+        }
+    }
+}
+
+void BusPorts::write(int value) {
+    for (int i=0; i<16; i++) {
+        if (_pin[i] != 0) {
+            gpio_write(_pin[i], (value >> i) & 1);
+        }
+    }
+}
+
+int BusPorts::read() {
+    int v = 0;
+    for (int i=0; i<16; i++) {
+        if (_pin[i] != 0) {
+            v |= gpio_read(_pin[i]) << i;
+        }
+    }
+    return v;
+}
+
+void BusPorts::dir(PinDirection dir) {
+    for (int i=0; i<16; i++) {
+        if (_pin[i] != 0) {
+            gpio_dir(_pin[i], dir);
+        }
+    }
+}
+
+void BusPorts::mode(PinMode pull) {
+    for (int i=0; i<16; i++) {
+        if (_pin[i] != 0) {
+            gpio_mode(_pin[i], pull);
+        }
+    }
+}
+
+#endif
+
+} // namespace mbed
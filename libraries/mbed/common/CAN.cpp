@@ -76,6 +76,15 @@ void CAN::attach(void (*fptr)(void), IrqType type) {
     }
 }
 
+void CAN::attach(Callback<void()> func, IrqType type) {
+    if (func.attached()) {
+        _irq[(CanIrqType)type] = func;
+        can_irq_set(&_can, (CanIrqType)type, 1);
+    } else {
+        can_irq_set(&_can, (CanIrqType)type, 0);
+    }
+}
+
 void CAN::_irq_handler(uint32_t id, CanIrqType type) {
     CAN *handler = (CAN*)id;
     handler->_irq[type].call();
@@ -14,19 +14,25 @@
  * limitations under the License.
  */
 #include "FileBase.h"
+#include "PlatformMutex.h"
 
 namespace mbed {
 
-FileBase *FileBase::_head = NULL;
+FileBase *FileBase::_buckets[FILEBASE_HASH_SIZE];
+
+static PlatformMutex buckets_mutex;
 
 FileBase::FileBase(const char *name, PathType t) {
     _name = name;
     _path_type = t;
 
     if (name != NULL) {
-        // put this object at head of the list
-        _next = _head;
-        _head = this;
+        // put this object at head of its bucket
+        FileBase **bucket = &_buckets[hash(name, std::strlen(name))];
+        buckets_mutex.lock();
+        _next = *bucket;
+        *bucket = this;
+        buckets_mutex.unlock();
     } else {
         _next = NULL;
     }
@@ -34,41 +40,54 @@ FileBase::FileBase(const char *name, PathType t) {
 
 FileBase::~FileBase() {
     if (_name != NULL) {
-        // remove this object from the list
-        if (_head == this) { // first in the list, so just drop me
-            _head = _next;
-        } else {             // find the object before me, then drop me
-            FileBase *p = _head;
-            while (p->_next != this) {
-                p = p->_next;
-            }
-            p->_next = _next;
+        // find the pointer to me, then drop me
+        FileBase **p = &_buckets[hash(_name, std::strlen(_name))];
+        buckets_mutex.lock();
+        while (*p != this) {
+            p = &(*p)->_next;
         }
+        *p = _next;
+        buckets_mutex.unlock();
+    }
+}
+
+unsigned int FileBase::hash(const char *name, unsigned int len) {
+    unsigned int h = 0;
+    for (unsigned int i = 0; i < len; i++) {
+        h = h * 31 + (unsigned char)name[i];
     }
+    return h % FILEBASE_HASH_SIZE;
 }
 
 FileBase *FileBase::lookup(const char *name, unsigned int len) {
-    FileBase *p = _head;
+    buckets_mutex.lock();
+    FileBase *p = _buckets[hash(name, len)];
     while (p != NULL) {
         /* Check that p->_name matches name and is the correct length */
-        if (p->_name != NULL && std::strncmp(p->_name, name, len) == 0 && std::strlen(p->_name) == len) {
-            return p;
+        if (std::strncmp(p->_name, name, len) == 0 && p->_name[len] == '\0') {
+            break;
         }
         p = p->_next;
     }
-    return NULL;
+    buckets_mutex.unlock();
+    return p;
 }
 
 FileBase *FileBase::get(int n) {
-    FileBase *p = _head;
+    FileBase *found = NULL;
     int m = 0;
-    while (p != NULL) {
-        if (m == n) return p;
-
-        m++;
-        p = p->_next;
+    buckets_mutex.lock();
+    for (int b = 0; b < FILEBASE_HASH_SIZE && found == NULL; b++) {
+        for (FileBase *p = _buckets[b]; p != NULL; p = p->_next) {
+            if (m == n) {
+                found = p;
+                break;
+            }
+            m++;
+        }
     }
-    return NULL;
+    buckets_mutex.unlock();
+    return found;
 }
 
 const char* FileBase::getName(void) {
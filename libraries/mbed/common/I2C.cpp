@@ -15,6 +15,10 @@
  */
 #include "I2C.h"
 
+#if DEVICE_I2C_ASYNCH
+#include "cmsis.h"
+#endif
+
 #if DEVICE_I2C
 
 namespace mbed {
@@ -22,6 +26,9 @@ namespace mbed {
 I2C *I2C::_owner = NULL;
 
 I2C::I2C(PinName sda, PinName scl) {
+#if DEVICE_I2C_ASYNCH
+    _head = _tail = NULL;
+#endif
     // The init function also set the frequency to 100000
     i2c_init(&_i2c, sda, scl);
     _hz = 100000;
@@ -87,6 +94,57 @@ void I2C::stop(void) {
     i2c_stop(&_i2c);
 }
 
+#if DEVICE_I2C_ASYNCH
+int I2C::transfer(I2CTransaction *transaction, Callback<void(int)> done) {
+    __disable_irq();
+    if (transaction->_pending) {
+        __enable_irq();
+        return -1;
+    }
+    transaction->_done = done;
+    transaction->_pending = true;
+    transaction->_next = NULL;
+
+    bool idle = (_head == NULL);
+    if (idle) {
+        _head = transaction;
+    } else {
+        _tail->_next = transaction;
+    }
+    _tail = transaction;
+    __enable_irq();
+
+    if (idle) {
+        start_transfer();
+    }
+    return 0;
+}
+
+void I2C::start_transfer() {
+    I2CTransaction *t = _head;
+    aquire();
+    i2c_transfer_asynch(&_i2c, t->address, t->tx, t->tx_length, t->rx, t->rx_length,
+                        t->repeated ? 0 : 1, &I2C::_irq_handler, (uint32_t)this);
+}
+
+void I2C::_irq_handler(uint32_t id, int result) {
+    I2C *handler = (I2C*)id;
+    I2CTransaction *t = handler->_head;
+
+    // take the transaction off the queue first, so that the callback can
+    // queue it again; if that makes the queue non-empty, transfer() starts it
+    handler->_head = t->_next;
+    bool more = (handler->_head != NULL);
+    t->_result = result;
+    t->_pending = false;
+    t->_done.call(result);
+
+    if (more) {
+        handler->start_transfer();
+    }
+}
+#endif
+
 } // namespace mbed
 
 #endif
@@ -45,6 +45,15 @@ void InterruptIn::rise(void (*fptr)(void)) {
     }
 }
 
+void InterruptIn::rise(Callback<void()> func) {
+    if (func.attached()) {
+        _rise = func;
+        gpio_irq_set(&gpio_irq, IRQ_RISE, 1);
+    } else {
+        gpio_irq_set(&gpio_irq, IRQ_RISE, 0);
+    }
+}
+
 void InterruptIn::fall(void (*fptr)(void)) {
     if (fptr) {
         _fall.attach(fptr);
@@ -54,6 +63,15 @@ void InterruptIn::fall(void (*fptr)(void)) {
     }
 }
 
+void InterruptIn::fall(Callback<void()> func) {
+    if (func.attached()) {
+        _fall = func;
+        gpio_irq_set(&gpio_irq, IRQ_FALL, 1);
+    } else {
+        gpio_irq_set(&gpio_irq, IRQ_FALL, 0);
+    }
+}
+
 void InterruptIn::_irq_handler(uint32_t id, gpio_irq_event event) {
     InterruptIn *handler = (InterruptIn*)id;
     switch (event) {
@@ -0,0 +1,64 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "InterruptInGroup.h"
+
+#if DEVICE_INTERRUPTIN_GROUP
+
+namespace mbed {
+
+InterruptInGroup::InterruptInGroup(PortName port, int mask, PinDirection dir) {
+    port_init(&_port, port, mask, dir);
+    gpio_irq_group_init(&_group, port, mask, (&InterruptInGroup::_irq_handler), (uint32_t)this);
+}
+
+InterruptInGroup::~InterruptInGroup() {
+    gpio_irq_group_free(&_group);
+}
+
+int InterruptInGroup::read() {
+    return port_read(&_port);
+}
+
+void InterruptInGroup::mode(PinMode pull) {
+    port_mode(&_port, pull);
+}
+
+void InterruptInGroup::attach(void (*fptr)(int rise, int fall)) {
+    attach(Callback<void(int, int)>(fptr));
+}
+
+void InterruptInGroup::attach(Callback<void(int, int)> func) {
+    _function = func;
+    rise(func.attached());
+    fall(func.attached());
+}
+
+void InterruptInGroup::rise(bool enable) {
+    gpio_irq_group_set(&_group, IRQ_RISE, enable);
+}
+
+void InterruptInGroup::fall(bool enable) {
+    gpio_irq_group_set(&_group, IRQ_FALL, enable);
+}
+
+void InterruptInGroup::_irq_handler(uint32_t id, uint32_t rise, uint32_t fall) {
+    InterruptInGroup *handler = (InterruptInGroup*)id;
+    handler->_function.call(rise, fall);
+}
+
+} // namespace mbed
+
+#endif
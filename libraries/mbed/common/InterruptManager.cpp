@@ -1,13 +1,13 @@
 #include "InterruptManager.h"
 #include <string.h>
 
-#define CHAIN_INITIAL_SIZE    4
-
 namespace mbed {
 
 typedef void (*pvoidf)(void);
 
 InterruptManager* InterruptManager::_instance = NULL;
+InterruptManager::InterruptChain* InterruptManager::_chains[NVIC_NUM_VECTORS];
+bool InterruptManager::_chain_used[INTERRUPT_CHAIN_COUNT];
 
 InterruptManager* InterruptManager::get() {
     if (NULL == _instance)
@@ -16,7 +16,7 @@ InterruptManager* InterruptManager::get() {
 }
 
 InterruptManager::InterruptManager() {
-    memset(_chains, 0, NVIC_NUM_VECTORS * sizeof(CallChain*));
+    memset(_chains, 0, NVIC_NUM_VECTORS * sizeof(InterruptChain*));
 }
 
 void InterruptManager::destroy() {
@@ -31,15 +31,42 @@ void InterruptManager::destroy() {
 
 InterruptManager::~InterruptManager() {
     for(int i = 0; i < NVIC_NUM_VECTORS; i++)
-        if (NULL != _chains[i])
-            delete _chains[i];
+        if (NULL != _chains[i]) {
+            free_chain(_chains[i]);
+            _chains[i] = NULL;
+        }
+}
+
+// A function static, so that the pool is constructed by its first use, even
+// from the constructor of a global object
+InterruptManager::InterruptChain* InterruptManager::chain_pool() {
+    static InterruptChain pool[INTERRUPT_CHAIN_COUNT];
+    return pool;
+}
+
+InterruptManager::InterruptChain* InterruptManager::alloc_chain() {
+    for (int i = 0; i < INTERRUPT_CHAIN_COUNT; i++) {
+        if (!_chain_used[i]) {
+            _chain_used[i] = true;
+            InterruptChain *chain = &chain_pool()[i];
+            chain->clear();
+            return chain;
+        }
+    }
+    return NULL;
+}
+
+void InterruptManager::free_chain(InterruptChain *chain) {
+    _chain_used[chain - chain_pool()] = false;
 }
 
 bool InterruptManager::must_replace_vector(IRQn_Type irq) {
     int irq_pos = get_irq_index(irq);
 
     if (NULL == _chains[irq_pos]) {
-        _chains[irq_pos] = new CallChain(CHAIN_INITIAL_SIZE);
+        _chains[irq_pos] = alloc_chain();
+        if (NULL == _chains[irq_pos])
+            return false;
         _chains[irq_pos]->add((pvoidf)NVIC_GetVector(irq));
         return true;
     }
@@ -49,10 +76,12 @@ bool InterruptManager::must_replace_vector(IRQn_Type irq) {
 pFunctionPointer_t InterruptManager::add_common(void (*function)(void), IRQn_Type irq, bool front) {
     int irq_pos = get_irq_index(irq);
     bool change = must_replace_vector(irq);
+    if (NULL == _chains[irq_pos])
+        return NULL;
 
     pFunctionPointer_t pf = front ? _chains[irq_pos]->add_front(function) : _chains[irq_pos]->add(function);
     if (change)
-        NVIC_SetVector(irq, (uint32_t)&InterruptManager::static_irq_helper);
+        NVIC_SetVector(irq, (uint32_t)get_dispatcher(irq_pos));
     return pf;
 }
 
@@ -67,7 +96,7 @@ bool InterruptManager::remove_handler(pFunctionPointer_t handler, IRQn_Type irq)
     // to call that function directly. This way we save both time and space.
     if (_chains[irq_pos]->size() == 1 && NULL != _chains[irq_pos]->get(0)->get_function()) {
         NVIC_SetVector(irq, (uint32_t)_chains[irq_pos]->get(0)->get_function());
-        delete _chains[irq_pos];
+        free_chain(_chains[irq_pos]);
         _chains[irq_pos] = NULL;
     }
     return true;
@@ -82,8 +111,41 @@ int InterruptManager::get_irq_index(IRQn_Type irq) {
 }
 
 void InterruptManager::static_irq_helper() {
-    InterruptManager::get()->irq_helper();
+    _chains[__get_IPSR()]->call();
+}
+
+#if INTERRUPT_DIRECT_DISPATCH
+template<int I>
+void InterruptManager::irq_thunk() {
+    _chains[I]->call();
+}
+
+// Finds the trampoline of a vector by binary search over the vector range,
+// which keeps the template instantiation depth logarithmic
+template<int FIRST, int COUNT>
+struct InterruptManager::ThunkTable {
+    static pvoidf_t get(int irq_pos) {
+        if (irq_pos < FIRST + COUNT / 2)
+            return ThunkTable<FIRST, COUNT / 2>::get(irq_pos);
+        return ThunkTable<FIRST + COUNT / 2, COUNT - COUNT / 2>::get(irq_pos);
+    }
+};
+
+template<int FIRST>
+struct InterruptManager::ThunkTable<FIRST, 1> {
+    static pvoidf_t get(int irq_pos) {
+        return &InterruptManager::irq_thunk<FIRST>;
+    }
+};
+
+pvoidf_t InterruptManager::get_dispatcher(int irq_pos) {
+    return ThunkTable<0, NVIC_NUM_VECTORS>::get(irq_pos);
+}
+#else
+pvoidf_t InterruptManager::get_dispatcher(int irq_pos) {
+    return &InterruptManager::static_irq_helper;
 }
+#endif
 
 } // namespace mbed
 
@@ -0,0 +1,107 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "PlatformMutex.h"
+#include "toolchain.h"
+#include "cmsis.h"
+#include <stddef.h>
+
+#if MBED_THREAD_SAFE
+
+// Resolved to the RTX functions when the RTOS is linked, NULL otherwise.
+// cmsis_os.h is not available here: the handles are passed as pointers.
+extern "C" {
+int32_t osKernelRunning(void) WEAK;
+void *osMutexCreate(void *mutex_def) WEAK;
+int32_t osMutexWait(void *mutex_id, uint32_t millisec) WEAK;
+int32_t osMutexRelease(void *mutex_id) WEAK;
+int32_t osMutexDelete(void *mutex_id) WEAK;
+int32_t osDelay(uint32_t millisec) WEAK;
+}
+
+#define osWaitForever   0xFFFFFFFF
+
+enum {
+    UNCREATED,
+    CREATING,
+    CREATED
+};
+
+namespace mbed {
+
+PlatformMutex::PlatformMutex() : _id(NULL), _def(_data), _state(UNCREATED) {
+}
+
+PlatformMutex::~PlatformMutex() {
+    if (_state == CREATED) {
+        osMutexDelete(_id);
+    }
+}
+
+// The first thread to lock creates the RTX mutex; the others wait for it
+void PlatformMutex::create() {
+    __disable_irq();
+    bool mine = (_state == UNCREATED);
+    if (mine) {
+        _state = CREATING;
+    }
+    __enable_irq();
+
+    if (mine) {
+        _id = osMutexCreate(&_def);
+        _state = CREATED;
+    } else {
+        while (_state != CREATED) {
+            osDelay(1);
+        }
+    }
+}
+
+// An interrupt handler cannot wait, nor create the RTX mutex
+void PlatformMutex::lock() {
+    if (osKernelRunning == NULL || !osKernelRunning() || __get_IPSR() != 0)
+        return;
+    if (_state != CREATED)
+        create();
+    osMutexWait(_id, osWaitForever);
+}
+
+void PlatformMutex::unlock() {
+    if (osKernelRunning == NULL || !osKernelRunning() || __get_IPSR() != 0)
+        return;
+    osMutexRelease(_id);
+}
+
+} // namespace mbed
+
+#else
+
+namespace mbed {
+
+PlatformMutex::PlatformMutex() {
+}
+
+PlatformMutex::~PlatformMutex() {
+}
+
+void PlatformMutex::lock() {
+}
+
+void PlatformMutex::unlock() {
+}
+
+} // namespace mbed
+
+#endif
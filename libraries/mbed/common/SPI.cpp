@@ -57,6 +57,34 @@ int SPI::write(int value) {
     return spi_master_write(&_spi, value);
 }
 
+#if DEVICE_SPI_BLOCK
+void SPI::transfer(const void *tx, void *rx, size_t length, Callback<void()> done) {
+#if DEVICE_SPI_DMA
+    // a transfer in the background must finish before the SPI is touched
+    while (spi_master_dma_busy(&_spi));
+#endif
+    aquire();
+#if DEVICE_SPI_DMA
+    if (done.attached()) {
+        _done = done;
+        if (spi_master_transfer_dma(&_spi, tx, rx, length, &SPI::_dma_handler, (uint32_t)this) == 0)
+            return;
+    }
+#endif
+    spi_master_block_write(&_spi, tx, rx, length);
+    if (done.attached()) {
+        done.call();
+    }
+}
+
+#if DEVICE_SPI_DMA
+void SPI::_dma_handler(uint32_t id) {
+    SPI *handler = (SPI*)id;
+    handler->_done.call();
+}
+#endif
+#endif
+
 } // namespace mbed
 
 #endif
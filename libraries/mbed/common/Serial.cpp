@@ -31,6 +31,10 @@ int Serial::_putc(int c) {
     return _base_putc(c);
 }
 
+int Serial::_readable() {
+    return readable();
+}
+
 } // namespace mbed
 
 #endif
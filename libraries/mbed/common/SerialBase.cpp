@@ -53,6 +53,15 @@ void SerialBase::attach(void (*fptr)(void), IrqType type) {
     }
 }
 
+void SerialBase::attach(Callback<void()> func, IrqType type) {
+    if (func.attached()) {
+        _irq[type] = func;
+        serial_irq_set(&_serial, (SerialIrq)type, 1);
+    } else {
+        serial_irq_set(&_serial, (SerialIrq)type, 0);
+    }
+}
+
 void SerialBase::_irq_handler(uint32_t id, SerialIrq irq_type) {
     SerialBase *handler = (SerialBase*)id;
     handler->_irq[irq_type].call();
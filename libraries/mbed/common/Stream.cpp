@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 #include "Stream.h"
+#include "mbed_printf.h"
 
 #include <cstdarg>
+#include <cstring>
 
 namespace mbed {
 
@@ -31,20 +33,22 @@ Stream::~Stream() {
     fclose(_file);
 }
 
+// Only input goes through _file, so it never has to be flushed to switch
+// between reading and writing
 int Stream::putc(int c) {
-    fflush(_file);
-    return std::fputc(c, _file);
+    return _putc(c);
 }
 int Stream::puts(const char *s) {
-    fflush(_file);
-    return std::fputs(s, _file);
+    size_t length = strlen(s);
+    _mutex.lock();
+    int r = (write(s, length) == (ssize_t)length) ? 0 : EOF;
+    _mutex.unlock();
+    return r;
 }
 int Stream::getc() {
-    fflush(_file);
     return std::fgetc(_file);
 }
 char* Stream::gets(char *s, int size) {
-    fflush(_file);
     return std::fgets(s,size,_file);
 }
 
@@ -70,6 +74,7 @@ ssize_t Stream::read(void* buffer, size_t length) {
         int c = _getc();
         if (c==EOF) break;
         *ptr++ = c;
+        if (!_readable()) break;
     }
     return ptr - (const char*)buffer;
 }
@@ -90,19 +95,83 @@ off_t Stream::flen() {
     return 0;
 }
 
+#if STREAM_MBED_PRINTF
+
+struct StreamOutput {
+    FileHandle *file;       // the Stream, through its public interface
+    char buffer[STREAM_PRINTF_BUFFER];
+    size_t length;
+    bool error;
+};
+
+static void stream_flush(StreamOutput *s) {
+    if (s->length > 0 && !s->error) {
+        s->error = (s->file->write(s->buffer, s->length) != (ssize_t)s->length);
+    }
+    s->length = 0;
+}
+
+static void stream_out(void *context, const char *data, size_t length) {
+    StreamOutput *s = (StreamOutput *)context;
+    while (length > 0) {
+        size_t n = sizeof(s->buffer) - s->length;
+        if (n > length)
+            n = length;
+        std::memcpy(s->buffer + s->length, data, n);
+        s->length += n;
+        data += n;
+        length -= n;
+        if (s->length == sizeof(s->buffer))
+            stream_flush(s);
+    }
+}
+
 int Stream::printf(const char* format, ...) {
+    StreamOutput out;
+    out.file = this;
+    out.length = 0;
+    out.error = false;
     std::va_list arg;
     va_start(arg, format);
-    fflush(_file);
-    int r = vfprintf(_file, format, arg);
+    _mutex.lock();
+    int r = mbed_vxprintf(stream_out, &out, format, arg);
+    stream_flush(&out);
+    _mutex.unlock();
+    va_end(arg);
+    return out.error ? EOF : r;
+}
+
+#else
+
+int Stream::printf(const char* format, ...) {
+    char buffer[STREAM_PRINTF_BUFFER];
+    std::va_list arg;
+    va_start(arg, format);
+    int r = vsnprintf(buffer, sizeof(buffer), format, arg);
+    va_end(arg);
+    if (r < 0)
+        return r;
+    if (r < (int)sizeof(buffer)) {
+        _mutex.lock();
+        r = (write(buffer, r) == r) ? r : EOF;
+        _mutex.unlock();
+        return r;
+    }
+
+    // too long for the buffer
+    va_start(arg, format);
+    _mutex.lock();
+    r = vfprintf(_file, format, arg);
+    _mutex.unlock();
     va_end(arg);
     return r;
 }
 
+#endif
+
 int Stream::scanf(const char* format, ...) {
     std::va_list arg;
     va_start(arg, format);
-    fflush(_file);
     int r = vfscanf(_file, format, arg);
     va_end(arg);
     return r;
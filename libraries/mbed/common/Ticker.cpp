@@ -17,6 +17,7 @@
 
 #include "TimerEvent.h"
 #include "FunctionPointer.h"
+#include "Callback.h"
 
 namespace mbed {
 
@@ -25,14 +26,14 @@ void Ticker::detach() {
     _function.attach(0);
 }
 
-void Ticker::setup(unsigned int t) {
+void Ticker::setup(us_timestamp_t t) {
     remove();
     _delay = t;
-    insert(_delay + us_ticker_read());
+    insert_absolute(_delay + us_ticker_read64());
 }
 
 void Ticker::handler() {
-    insert(event.timestamp + _delay);
+    insert_absolute(event.timestamp + _delay);
     _function.call();
 }
 
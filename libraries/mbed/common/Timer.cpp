@@ -23,7 +23,7 @@ Timer::Timer() {
 }
 
 void Timer::start() {
-    _start = us_ticker_read();
+    _start = us_ticker_read64();
     _running = 1;
 }
 
@@ -33,27 +33,31 @@ void Timer::stop() {
 }
 
 int Timer::read_us() {
+    return read_high_resolution_us();
+}
+
+us_timestamp_t Timer::read_high_resolution_us() {
     return _time + slicetime();
 }
 
 float Timer::read() {
-    return (float)read_us() / 1000000.0f;
+    return (float)read_high_resolution_us() / 1000000.0f;
 }
 
 int Timer::read_ms() {
-    return read_us() / 1000;
+    return read_high_resolution_us() / 1000;
 }
 
-int Timer::slicetime() {
+us_timestamp_t Timer::slicetime() {
     if (_running) {
-        return us_ticker_read() - _start;
+        return us_ticker_read64() - _start;
     } else {
         return 0;
     }
 }
 
 void Timer::reset() {
-    _start = us_ticker_read();
+    _start = us_ticker_read64();
     _time = 0;
 }
 
@@ -21,6 +21,7 @@
 namespace mbed {
 
 TimerEvent::TimerEvent() {
+    us_ticker_init_event(&event);
     us_ticker_set_handler((&TimerEvent::irq));
 }
 
@@ -33,11 +34,15 @@ TimerEvent::~TimerEvent() {
     remove();
 }
 
-// insert in to linked list
+// insert in to the event queue
 void TimerEvent::insert(unsigned int timestamp) {
     us_ticker_insert_event(&event, timestamp, (uint32_t)this);
 }
 
+void TimerEvent::insert_absolute(us_timestamp_t timestamp) {
+    us_ticker_insert_event64(&event, timestamp, (uint32_t)this);
+}
+
 void TimerEvent::remove() {
     us_ticker_remove_event(&event);
 }
@@ -0,0 +1,917 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_printf.h"
+#include <stdint.h>
+#include <string.h>
+
+#ifndef va_copy
+#define va_copy(dst, src) __va_copy(dst, src)
+#endif
+
+using namespace mbed;
+
+typedef PrintfFormat::Spec Spec;
+
+enum {
+    FLAG_LEFT  = 1 << 0,
+    FLAG_PLUS  = 1 << 1,
+    FLAG_SPACE = 1 << 2,
+    FLAG_ZERO  = 1 << 3,
+    FLAG_ALT   = 1 << 4
+};
+
+#define ARG_WIDTH   -2  // width or precision given by an argument
+#define MAX_PREC    40  // precision of floating point conversions
+
+#define MAX_INT_DIGITS  309 // digits of the largest double
+#define INT_LIMBS       33  // 32 bit words of the largest double, and a spare
+#define FRAC_LIMBS      34  // 32 bit words of the smallest fraction, 2^-1074
+
+/******************************************************************************
+ * Output
+ ******************************************************************************/
+
+struct Output {
+    mbed_printf_out out;
+    void *context;
+    int count;
+};
+
+static void emit(Output &o, const char *data, size_t length) {
+    if (length > 0) {
+        o.out(o.context, data, length);
+        o.count += length;
+    }
+}
+
+static void emit_fill(Output &o, char c, int n) {
+    char fill[16];
+    memset(fill, c, sizeof(fill));
+    while (n > 0) {
+        int k = (n > (int)sizeof(fill)) ? sizeof(fill) : n;
+        emit(o, fill, k);
+        n -= k;
+    }
+}
+
+/* Write a field: prefix (sign, 0x), zeros, body, padded to width */
+static void emit_field(Output &o, const Spec &s, int width, const char *prefix, int prefix_len,
+                       int zeros, const char *body, int body_len, bool zero_pad) {
+    int len = prefix_len + zeros + body_len;
+    if ((s.flags & (FLAG_ZERO | FLAG_LEFT)) == FLAG_ZERO && zero_pad && width > len) {
+        zeros += width - len;
+        len = width;
+    }
+    if (!(s.flags & FLAG_LEFT))
+        emit_fill(o, ' ', width - len);
+    emit(o, prefix, prefix_len);
+    emit_fill(o, '0', zeros);
+    emit(o, body, body_len);
+    if (s.flags & FLAG_LEFT)
+        emit_fill(o, ' ', width - len);
+}
+
+/******************************************************************************
+ * Parsing
+ ******************************************************************************/
+
+static const char *parse_number(const char *p, int &n) {
+    n = 0;
+    while (*p >= '0' && *p <= '9') {
+        n = n * 10 + (*p++ - '0');
+    }
+    return p;
+}
+
+/* Parse the conversion starting at the '%' at p; returns the end of it */
+static const char *parse_spec(const char *p, Spec &s) {
+    p++;
+    s.flags = 0;
+    for (;; p++) {
+        switch (*p) {
+            case '-': s.flags |= FLAG_LEFT;  continue;
+            case '+': s.flags |= FLAG_PLUS;  continue;
+            case ' ': s.flags |= FLAG_SPACE; continue;
+            case '0': s.flags |= FLAG_ZERO;  continue;
+            case '#': s.flags |= FLAG_ALT;   continue;
+        }
+        break;
+    }
+
+    s.width = -1;
+    if (*p == '*') {
+        s.width = ARG_WIDTH;
+        p++;
+    } else if (*p >= '0' && *p <= '9') {
+        p = parse_number(p, s.width);
+    }
+
+    s.precision = -1;
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            s.precision = ARG_WIDTH;
+            p++;
+        } else {
+            p = parse_number(p, s.precision);
+        }
+    }
+
+    // hh and ll are recorded as H and L
+    s.length = 0;
+    switch (*p) {
+        case 'h':
+            s.length = (p[1] == 'h') ? 'H' : 'h';
+            p += (p[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            s.length = (p[1] == 'l') ? 'L' : 'l';
+            p += (p[1] == 'l') ? 2 : 1;
+            break;
+        case 'z': case 'j': case 't': case 'L':
+            s.length = *p++;
+            break;
+    }
+
+    s.conversion = *p;
+    if (*p != '\0')
+        p++;
+    return p;
+}
+
+/******************************************************************************
+ * Arguments
+ ******************************************************************************/
+
+/* Where the values come from: a va_list, or an array of PrintfArg */
+struct Args {
+    va_list ap;
+    bool va;
+    const PrintfArg *args;
+    int count;
+    int next;
+};
+
+static PrintfArg next_arg(Args &a) {
+    return (a.next < a.count) ? a.args[a.next++] : PrintfArg(0);
+}
+
+static int next_int(Args &a) {
+    if (a.va)
+        return va_arg(a.ap, int);
+    PrintfArg arg = next_arg(a);
+    return (arg.kind == PrintfArg::Float) ? (int)arg.value.d : (int)arg.value.i;
+}
+
+/* Fetch the value of a conversion from a va_list, with the type the
+ * conversion and its length modifier call for */
+static PrintfArg va_value(Args &a, const Spec &s) {
+    switch (s.conversion) {
+        case 'd': case 'i':
+            switch (s.length) {
+                case 'l': return PrintfArg(va_arg(a.ap, long));
+                case 'L': return PrintfArg(va_arg(a.ap, long long));
+                case 'j': return PrintfArg((long long)va_arg(a.ap, intmax_t));
+                case 'z': return PrintfArg((long long)(ptrdiff_t)va_arg(a.ap, size_t));
+                case 't': return PrintfArg((long long)va_arg(a.ap, ptrdiff_t));
+                default:  return PrintfArg(va_arg(a.ap, int));
+            }
+        case 'u': case 'o': case 'x': case 'X':
+            switch (s.length) {
+                case 'l': return PrintfArg(va_arg(a.ap, unsigned long));
+                case 'L': return PrintfArg(va_arg(a.ap, unsigned long long));
+                case 'j': return PrintfArg((unsigned long long)va_arg(a.ap, uintmax_t));
+                case 'z': return PrintfArg((unsigned long long)va_arg(a.ap, size_t));
+                case 't': return PrintfArg((unsigned long long)va_arg(a.ap, ptrdiff_t));
+                default:  return PrintfArg(va_arg(a.ap, unsigned int));
+            }
+        case 'c':
+            return PrintfArg(va_arg(a.ap, int));
+        case 's': case 'p':
+            return PrintfArg(va_arg(a.ap, const void *));
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            return PrintfArg(va_arg(a.ap, double));
+    }
+    return PrintfArg(0);
+}
+
+/******************************************************************************
+ * Integers
+ ******************************************************************************/
+
+static const char lower_digits[] = "0123456789abcdef";
+static const char upper_digits[] = "0123456789ABCDEF";
+
+/* Write the digits of v backwards, ending at end; nothing for 0 */
+static char *utoa_rev(char *end, unsigned long long v, unsigned base, const char *digits) {
+    char *p = end;
+    // most values fit in 32 bits, where division is a single instruction
+    while (v > 0xFFFFFFFFUL) {
+        *--p = digits[v % base];
+        v /= base;
+    }
+    uint32_t w = (uint32_t)v;
+    while (w != 0) {
+        *--p = digits[w % base];
+        w /= base;
+    }
+    return p;
+}
+
+static void format_int(Output &o, const Spec &s, int width, int precision, const PrintfArg &arg) {
+    unsigned long long v;
+    bool negative = false;
+    char prefix[2];
+    int prefix_len = 0;
+
+    if (s.conversion == 'd' || s.conversion == 'i') {
+        long long i = (arg.kind == PrintfArg::Float) ? (long long)arg.value.d : arg.value.i;
+        if (s.length == 'H') {
+            i = (signed char)i;
+        } else if (s.length == 'h') {
+            i = (short)i;
+        }
+        negative = i < 0;
+        v = negative ? 0ULL - (unsigned long long)i : (unsigned long long)i;
+        if (negative) {
+            prefix[prefix_len++] = '-';
+        } else if (s.flags & FLAG_PLUS) {
+            prefix[prefix_len++] = '+';
+        } else if (s.flags & FLAG_SPACE) {
+            prefix[prefix_len++] = ' ';
+        }
+    } else {
+        if (arg.kind == PrintfArg::Float) {
+            v = (unsigned long long)arg.value.d;
+        } else if (arg.kind == PrintfArg::Signed && s.length != 'L' && s.length != 'j'
+                   && arg.value.i >= -2147483647LL - 1 && arg.value.i <= 2147483647LL) {
+            // a negative int printed as unsigned is 32 bits wide
+            v = (uint32_t)arg.value.i;
+        } else {
+            v = arg.value.u;
+        }
+        if (s.length == 'H') {
+            v = (unsigned char)v;
+        } else if (s.length == 'h') {
+            v = (unsigned short)v;
+        }
+    }
+
+    unsigned base = 10;
+    const char *digits = lower_digits;
+    switch (s.conversion) {
+        case 'o':
+            base = 8;
+            break;
+        case 'X':
+            digits = upper_digits;
+            // fall through
+        case 'x':
+            base = 16;
+            if ((s.flags & FLAG_ALT) && v != 0) {
+                prefix[prefix_len++] = '0';
+                prefix[prefix_len++] = s.conversion;
+            }
+            break;
+    }
+
+    char buf[24];
+    char *end = buf + sizeof(buf);
+    char *start = utoa_rev(end, v, base, digits);
+    int len = end - start;
+
+    int zeros = (precision > len) ? precision - len : 0;
+    if (precision < 0 && len == 0) {
+        zeros = 1;
+    }
+    if (base == 8 && (s.flags & FLAG_ALT) && zeros == 0 && (len == 0 || *start != '0')) {
+        zeros = 1;
+    }
+
+    // the 0 flag is ignored when a precision is given
+    emit_field(o, s, width, prefix, prefix_len, zeros, start, len, precision < 0);
+}
+
+static void format_char(Output &o, const Spec &s, int width, const PrintfArg &arg) {
+    char c = (char)arg.value.i;
+    emit_field(o, s, width, NULL, 0, 0, &c, 1, false);
+}
+
+static void format_string(Output &o, const Spec &s, int width, int precision, const PrintfArg &arg) {
+    const char *str = (arg.kind == PrintfArg::Pointer && arg.value.p != NULL)
+                    ? (const char *)arg.value.p : "(null)";
+    int len = 0;
+    while ((precision < 0 || len < precision) && str[len] != '\0') {
+        len++;
+    }
+    emit_field(o, s, width, NULL, 0, 0, str, len, false);
+}
+
+static void format_pointer(Output &o, const Spec &s, int width, const PrintfArg &arg) {
+    char buf[2 * sizeof(void *)];
+    char *end = buf + sizeof(buf);
+    char *start = utoa_rev(end, (uintptr_t)arg.value.p, 16, lower_digits);
+    emit_field(o, s, width, "0x", 2, (start == end) ? 1 : 0, start, end - start, false);
+}
+
+/******************************************************************************
+ * Floating point
+ ******************************************************************************/
+
+#if MBED_PRINTF_FLOAT
+
+/* The exact decimal digits of a finite double v >= 0 = mant * 2^exp2: the
+ * integer part all at once, then the fraction one digit at a time */
+struct Decimal {
+    unsigned long long mant;
+    int exp2;
+    int limbs;
+    uint32_t frac[FRAC_LIMBS];  // the fraction, scaled by 2^(32 * limbs)
+};
+
+static void decimal_init(Decimal &d, double v) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    int biased = (int)(bits >> 52) & 0x7FF;
+    d.mant = bits & ((1ULL << 52) - 1);
+    if (biased == 0) {
+        biased = 1;
+    } else {
+        d.mant |= 1ULL << 52;
+    }
+    d.exp2 = biased - 1075;
+    d.limbs = 0;
+    if (d.exp2 >= 0) {
+        return;
+    }
+
+    // put the binary point of the fraction on a limb boundary
+    int fbits = -d.exp2;
+    unsigned long long f = (fbits >= 64) ? d.mant : d.mant & ((1ULL << fbits) - 1);
+    d.limbs = (fbits + 31) / 32;
+    int shift = d.limbs * 32 - fbits;
+    memset(d.frac, 0, d.limbs * sizeof(uint32_t));
+    unsigned long long low = f << shift;
+    d.frac[0] = (uint32_t)low;
+    if (d.limbs > 1) {
+        d.frac[1] = (uint32_t)(low >> 32);
+    }
+    if (d.limbs > 2 && shift > 0) {
+        d.frac[2] = (uint32_t)(f >> (64 - shift));
+    }
+}
+
+/* Write the digits of the integer part; returns their number, 0 for 0 */
+static int decimal_int(const Decimal &d, char *buf) {
+    char tmp[20];
+    char *end = tmp + sizeof(tmp);
+    char *start;
+    if (d.exp2 <= 11) {
+        unsigned long long ip = (d.exp2 >= 0) ? d.mant << d.exp2
+                              : (d.exp2 > -64) ? d.mant >> -d.exp2 : 0;
+        start = utoa_rev(end, ip, 10, lower_digits);
+        memcpy(buf, start, end - start);
+        return end - start;
+    }
+
+    // mant << exp2 as a big number, divided by 10^9 until nothing is left
+    uint32_t n[INT_LIMBS];
+    int word = d.exp2 / 32, bit = d.exp2 % 32;
+    memset(n, 0, sizeof(n));
+    unsigned long long low = d.mant << bit;
+    n[word] = (uint32_t)low;
+    n[word + 1] = (uint32_t)(low >> 32);
+    if (bit > 0) {
+        n[word + 2] = (uint32_t)(d.mant >> (64 - bit));
+    }
+    int top = word + 2;
+
+    uint32_t chunks[MAX_INT_DIGITS / 9 + 1];
+    int count = 0;
+    while (top >= 0) {
+        uint32_t rem = 0;
+        for (int i = top; i >= 0; i--) {
+            unsigned long long x = ((unsigned long long)rem << 32) | n[i];
+            n[i] = (uint32_t)(x / 1000000000);
+            rem = (uint32_t)(x % 1000000000);
+        }
+        chunks[count++] = rem;
+        while (top >= 0 && n[top] == 0) {
+            top--;
+        }
+    }
+
+    start = utoa_rev(end, chunks[--count], 10, lower_digits);
+    int len = end - start;
+    memcpy(buf, start, len);
+    while (count > 0) {
+        uint32_t c = chunks[--count];
+        for (int i = 8; i >= 0; i--) {
+            buf[len + i] = '0' + c % 10;
+            c /= 10;
+        }
+        len += 9;
+    }
+    return len;
+}
+
+/* The next digit of the fraction */
+static int decimal_frac_digit(Decimal &d) {
+    uint32_t carry = 0;
+    for (int i = 0; i < d.limbs; i++) {
+        unsigned long long x = (unsigned long long)d.frac[i] * 10 + carry;
+        d.frac[i] = (uint32_t)x;
+        carry = (uint32_t)(x >> 32);
+    }
+    return carry;
+}
+
+/* Whether the digits left in the fraction are not all 0 */
+static bool decimal_frac_rest(const Decimal &d) {
+    for (int i = 0; i < d.limbs; i++) {
+        if (d.frac[i] != 0)
+            return true;
+    }
+    return false;
+}
+
+/* Round the n digits of buf given the digit after them and whether anything
+ * non-zero follows, half to even; returns true when the digits all carried
+ * over, and are left as 0 */
+static bool round_digits(char *buf, int n, int next, bool rest) {
+    bool odd = (n > 0) && ((buf[n - 1] - '0') & 1);
+    if (next < 5 || (next == 5 && !rest && !odd)) {
+        return false;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        if (buf[i] != '9') {
+            buf[i]++;
+            return false;
+        }
+        buf[i] = '0';
+    }
+    return true;
+}
+
+/* Put the point after the first 'at' digits of the n in buf; returns the length */
+static int insert_point(char *buf, int n, int at) {
+    memmove(buf + at + 1, buf + at, n - at);
+    buf[at] = '.';
+    return n + 1;
+}
+
+/* Write v (>= 0) with precision fractional digits; returns the length */
+static int put_fixed(char *buf, double v, int precision, bool point) {
+    Decimal d;
+    decimal_init(d, v);
+    int n = decimal_int(d, buf);
+    if (n == 0) {
+        buf[n++] = '0';
+    }
+    int int_len = n;
+    for (int i = 0; i < precision; i++) {
+        buf[n++] = '0' + decimal_frac_digit(d);
+    }
+    int next = decimal_frac_digit(d);
+    if (round_digits(buf, n, next, decimal_frac_rest(d))) {
+        memmove(buf + 1, buf, n);
+        buf[0] = '1';
+        n++;
+        int_len++;
+    }
+    if (precision > 0 || point) {
+        n = insert_point(buf, n, int_len);
+    }
+    return n;
+}
+
+/* Write v (>= 0) as d.ddde+xx, and set exp to the exponent; returns the length */
+static int put_exp(char *buf, double v, int precision, bool point, char e_char, int &exp) {
+    int want = precision + 1;
+    int n = 0;
+    int next = 0;
+    bool rest = false;
+    int e = 0;
+
+    if (v == 0) {
+        memset(buf, '0', want);
+        n = want;
+    } else {
+        Decimal d;
+        decimal_init(d, v);
+        n = decimal_int(d, buf);
+        if (n > 0) {
+            e = n - 1;
+        } else {
+            // skip the zeros at the start of the fraction
+            int c;
+            e = -1;
+            while ((c = decimal_frac_digit(d)) == 0) {
+                e--;
+            }
+            buf[n++] = '0' + c;
+        }
+        if (n > want) {
+            // the rounding digit and the rest are in the integer part
+            next = buf[want] - '0';
+            rest = decimal_frac_rest(d);
+            for (int i = want + 1; i < n && !rest; i++) {
+                rest = (buf[i] != '0');
+            }
+            n = want;
+        } else {
+            while (n < want) {
+                buf[n++] = '0' + decimal_frac_digit(d);
+            }
+            next = decimal_frac_digit(d);
+            rest = decimal_frac_rest(d);
+        }
+    }
+    if (round_digits(buf, n, next, rest)) {
+        buf[0] = '1';
+        e++;
+    }
+    if (precision > 0 || point) {
+        n = insert_point(buf, n, 1);
+    }
+    exp = e;
+
+    buf[n++] = e_char;
+    if (e < 0) {
+        buf[n++] = '-';
+        e = -e;
+    } else {
+        buf[n++] = '+';
+    }
+    char tmp[4];
+    char *end = tmp + sizeof(tmp);
+    char *start = utoa_rev(end, e, 10, lower_digits);
+    while (end - start < 2) {
+        *--start = '0';
+    }
+    memcpy(buf + n, start, end - start);
+    return n + (end - start);
+}
+
+/* Remove the trailing zeros of the fraction, and the point if nothing is left */
+static int strip_zeros(char *buf, int n) {
+    int point = 0;
+    while (point < n && buf[point] != '.') {
+        point++;
+    }
+    if (point == n) {
+        return n;
+    }
+    int exp = point;
+    while (exp < n && buf[exp] != 'e' && buf[exp] != 'E') {
+        exp++;
+    }
+    int end = exp;
+    while (end > point + 1 && buf[end - 1] == '0') {
+        end--;
+    }
+    if (end == point + 1) {
+        end = point;
+    }
+    memmove(buf + end, buf + exp, n - exp);
+    return end + (n - exp);
+}
+
+static void format_float(Output &o, const Spec &s, int width, int precision, const PrintfArg &arg) {
+    double v;
+    switch (arg.kind) {
+        case PrintfArg::Float:  v = arg.value.d; break;
+        case PrintfArg::Signed: v = (double)arg.value.i; break;
+        default:                v = (double)arg.value.u; break;
+    }
+
+    bool upper = (s.conversion == 'F' || s.conversion == 'E' || s.conversion == 'G');
+    bool alt = (s.flags & FLAG_ALT) != 0;
+
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    char prefix[1];
+    int prefix_len = 0;
+    if (bits >> 63) {
+        prefix[prefix_len++] = '-';
+        v = -v;
+    } else if (s.flags & FLAG_PLUS) {
+        prefix[prefix_len++] = '+';
+    } else if (s.flags & FLAG_SPACE) {
+        prefix[prefix_len++] = ' ';
+    }
+
+    if (v != v || v > 1.7976931348623157e308) {
+        const char *text = (v != v) ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf");
+        emit_field(o, s, width, prefix, prefix_len, 0, text, 3, false);
+        return;
+    }
+
+    if (precision < 0) {
+        precision = 6;
+    } else if (precision > MAX_PREC) {
+        precision = MAX_PREC;
+    }
+
+    char buf[MAX_INT_DIGITS + MAX_PREC + 8];
+    char e_char = upper ? 'E' : 'e';
+    int n, x;
+    switch (s.conversion) {
+        case 'f': case 'F':
+            n = put_fixed(buf, v, precision, alt);
+            break;
+        case 'e': case 'E':
+            n = put_exp(buf, v, precision, alt, e_char, x);
+            break;
+        default: {
+            // the exponent of the %e form decides, after its rounding
+            int p = (precision == 0) ? 1 : precision;
+            n = put_exp(buf, v, p - 1, alt, e_char, x);
+            if (x < p && x >= -4 && p - 1 - x <= MAX_PREC) {
+                n = put_fixed(buf, v, p - 1 - x, alt);
+            }
+            if (!alt) {
+                n = strip_zeros(buf, n);
+            }
+            break;
+        }
+    }
+
+    emit_field(o, s, width, prefix, prefix_len, 0, buf, n, true);
+}
+
+#endif
+
+/******************************************************************************
+ * Formatting
+ ******************************************************************************/
+
+/* Format one conversion, taking its arguments from a */
+static void format_spec(Output &o, const char *format, const Spec &s, Args &a) {
+    int width = s.width;
+    int precision = s.precision;
+    Spec spec = s;
+
+    if (width == ARG_WIDTH) {
+        width = next_int(a);
+        if (width < 0) {
+            spec.flags |= FLAG_LEFT;
+            width = -width;
+        }
+    }
+    if (precision == ARG_WIDTH) {
+        precision = next_int(a);
+        if (precision < 0) {
+            precision = -1;
+        }
+    }
+
+    switch (s.conversion) {
+        case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+        case 'c': case 's': case 'p':
+#if MBED_PRINTF_FLOAT
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+#endif
+            break;
+        case '%':
+            emit(o, "%", 1);
+            return;
+        default:
+            // not a conversion: print it as it is
+            emit(o, format + s.start, s.end - s.start);
+            return;
+    }
+
+    PrintfArg arg = a.va ? va_value(a, s) : next_arg(a);
+    switch (s.conversion) {
+        case 'c':
+            format_char(o, spec, width, arg);
+            break;
+        case 's':
+            format_string(o, spec, width, precision, arg);
+            break;
+        case 'p':
+            format_pointer(o, spec, width, arg);
+            break;
+#if MBED_PRINTF_FLOAT
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+            format_float(o, spec, width, precision, arg);
+            break;
+#endif
+        default:
+            format_int(o, spec, width, precision, arg);
+            break;
+    }
+}
+
+/* Parse and format in one pass */
+static int format_all(Output &o, const char *format, Args &a) {
+    const char *p = format;
+    for (;;) {
+        const char *literal = p;
+        while (*p != '\0' && *p != '%') {
+            p++;
+        }
+        emit(o, literal, p - literal);
+        if (*p == '\0') {
+            return o.count;
+        }
+
+        Spec s;
+        const char *end = parse_spec(p, s);
+        // the offsets are relative to p, so that they fit in a Spec
+        s.start = 0;
+        s.end = end - p;
+        format_spec(o, p, s, a);
+        p = end;
+    }
+}
+
+/******************************************************************************
+ * Sinks
+ ******************************************************************************/
+
+struct StringOutput {
+    char *buffer;
+    size_t size;
+    size_t length;
+};
+
+static void string_out(void *context, const char *data, size_t length) {
+    StringOutput *s = (StringOutput *)context;
+    if (s->length + 1 < s->size) {
+        size_t n = s->size - 1 - s->length;
+        if (n > length) {
+            n = length;
+        }
+        memcpy(s->buffer + s->length, data, n);
+        s->length += n;
+    }
+}
+
+#define CONSOLE_BUFFER  64
+
+struct ConsoleOutput {
+    char buffer[CONSOLE_BUFFER];
+    size_t length;
+};
+
+static void console_flush(ConsoleOutput *c) {
+    if (c->length > 0) {
+        mbed_console_write(c->buffer, c->length);
+        c->length = 0;
+    }
+}
+
+static void console_out(void *context, const char *data, size_t length) {
+    ConsoleOutput *c = (ConsoleOutput *)context;
+    while (length > 0) {
+        if (c->length == 0 && length >= CONSOLE_BUFFER) {
+            mbed_console_write(data, length);
+            return;
+        }
+        size_t n = CONSOLE_BUFFER - c->length;
+        if (n > length) {
+            n = length;
+        }
+        memcpy(c->buffer + c->length, data, n);
+        c->length += n;
+        data += n;
+        length -= n;
+        if (c->length == CONSOLE_BUFFER) {
+            console_flush(c);
+        }
+    }
+}
+
+/******************************************************************************
+ * C API
+ ******************************************************************************/
+
+extern "C" int mbed_vxprintf(mbed_printf_out out, void *context, const char *format, va_list arg) {
+    Output o = {out, context, 0};
+    Args a;
+    va_copy(a.ap, arg);
+    a.va = true;
+    a.args = NULL;
+    a.count = a.next = 0;
+    int n = format_all(o, format, a);
+    va_end(a.ap);
+    return n;
+}
+
+extern "C" int mbed_vsnprintf(char *buffer, size_t size, const char *format, va_list arg) {
+    StringOutput s = {buffer, size, 0};
+    int n = mbed_vxprintf(string_out, &s, format, arg);
+    if (size > 0) {
+        buffer[s.length] = '\0';
+    }
+    return n;
+}
+
+extern "C" int mbed_snprintf(char *buffer, size_t size, const char *format, ...) {
+    va_list arg;
+    va_start(arg, format);
+    int n = mbed_vsnprintf(buffer, size, format, arg);
+    va_end(arg);
+    return n;
+}
+
+extern "C" int mbed_vprintf(const char *format, va_list arg) {
+    ConsoleOutput c;
+    c.length = 0;
+    int n = mbed_vxprintf(console_out, &c, format, arg);
+    console_flush(&c);
+    return n;
+}
+
+extern "C" int mbed_printf(const char *format, ...) {
+    va_list arg;
+    va_start(arg, format);
+    int n = mbed_vprintf(format, arg);
+    va_end(arg);
+    return n;
+}
+
+/******************************************************************************
+ * PrintfFormat
+ ******************************************************************************/
+
+namespace mbed {
+
+PrintfFormat::PrintfFormat(const char *format) : _format(format), _count(0) {
+    const char *p = format;
+    for (;;) {
+        while (*p != '\0' && *p != '%') {
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+        Spec s;
+        const char *end = parse_spec(p, s);
+        if (_count == MBED_PRINTF_MAX_SPECS || end - format > 0xFFFF) {
+            _count = -1;
+            return;
+        }
+        s.start = p - format;
+        s.end = end - format;
+        _specs[_count++] = s;
+        p = end;
+    }
+}
+
+int PrintfFormat::format(mbed_printf_out out, void *context, const PrintfArg *args, int count) const {
+    Output o = {out, context, 0};
+    Args a;
+    a.va = false;
+    a.args = args;
+    a.count = count;
+    a.next = 0;
+
+    if (_count < 0) {
+        return format_all(o, _format, a);
+    }
+
+    int pos = 0;
+    for (int i = 0; i < _count; i++) {
+        const Spec &s = _specs[i];
+        emit(o, _format + pos, s.start - pos);
+        format_spec(o, _format, s, a);
+        pos = s.end;
+    }
+    emit(o, _format + pos, strlen(_format + pos));
+    return o.count;
+}
+
+int PrintfFormat::print(const PrintfArg *args, int count) const {
+    ConsoleOutput c;
+    c.length = 0;
+    int n = format(console_out, &c, args, count);
+    console_flush(&c);
+    return n;
+}
+
+int PrintfFormat::sprint(char *buffer, size_t size, const PrintfArg *args, int count) const {
+    StringOutput s = {buffer, size, 0};
+    int n = format(string_out, &s, args, count);
+    if (size > 0) {
+        buffer[s.length] = '\0';
+    }
+    return n;
+}
+
+} // namespace mbed
@@ -0,0 +1,170 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mbed_trace.h"
+#include "FileHandle.h"
+#include "us_ticker_api.h"
+#include "cmsis.h"
+
+#define MASK    (MBED_TRACE_BUFFER - 1)
+
+/* The trace may be written inside a critical section of the caller: leave
+ * interrupts as they were found */
+#ifdef __CORTEX_M
+#define IRQ_SAVE()      uint32_t primask = __get_PRIMASK(); __disable_irq()
+#define IRQ_RESTORE()   __set_PRIMASK(primask)
+#else
+#define IRQ_SAVE()      __disable_irq()
+#define IRQ_RESTORE()   __enable_irq()
+#endif
+
+/* Slots are 0 until their record is complete: the header is written last,
+ * and the reader clears the slots before it frees them */
+static uint32_t ring[MBED_TRACE_BUFFER];
+static volatile uint32_t head;      // words reserved by the writers
+static volatile uint32_t tail;      // words freed by the reader
+static volatile uint32_t lost;      // records dropped since the last read
+
+/* Reserve n words from h; false if the ring is full */
+static inline bool reserve(uint32_t n, uint32_t &h) {
+#if (__CORTEX_M >= 0x03)
+    do {
+        h = __LDREXW(&head);
+        if (h + n - tail > MBED_TRACE_BUFFER) {
+            __CLREX();
+            uint32_t l;
+            do {
+                l = __LDREXW(&lost);
+            } while (__STREXW(l + 1, &lost));
+            return false;
+        }
+    } while (__STREXW(h + n, &head));
+    return true;
+#else
+    IRQ_SAVE();
+    h = head;
+    if (h + n - tail > MBED_TRACE_BUFFER) {
+        lost++;
+        IRQ_RESTORE();
+        return false;
+    }
+    head = h + n;
+    IRQ_RESTORE();
+    return true;
+#endif
+}
+
+static inline void commit(uint32_t h, const char *format, uint32_t nargs) {
+    ring[(h + 1) & MASK] = (uint32_t)format;
+    __DMB();
+    ring[h & MASK] = MBED_TRACE_VALID | (nargs << MBED_TRACE_ARGS_SHIFT)
+                   | (us_ticker_read() & MBED_TRACE_TIME_MASK);
+}
+
+extern "C" void mbed_trace0(const char *format) {
+    uint32_t h;
+    if (!reserve(2, h))
+        return;
+    commit(h, format, 0);
+}
+
+extern "C" void mbed_trace1(const char *format, uint32_t a0) {
+    uint32_t h;
+    if (!reserve(3, h))
+        return;
+    ring[(h + 2) & MASK] = a0;
+    commit(h, format, 1);
+}
+
+extern "C" void mbed_trace2(const char *format, uint32_t a0, uint32_t a1) {
+    uint32_t h;
+    if (!reserve(4, h))
+        return;
+    ring[(h + 2) & MASK] = a0;
+    ring[(h + 3) & MASK] = a1;
+    commit(h, format, 2);
+}
+
+extern "C" void mbed_trace3(const char *format, uint32_t a0, uint32_t a1, uint32_t a2) {
+    uint32_t h;
+    if (!reserve(5, h))
+        return;
+    ring[(h + 2) & MASK] = a0;
+    ring[(h + 3) & MASK] = a1;
+    ring[(h + 4) & MASK] = a2;
+    commit(h, format, 3);
+}
+
+extern "C" void mbed_trace4(const char *format, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    uint32_t h;
+    if (!reserve(6, h))
+        return;
+    ring[(h + 2) & MASK] = a0;
+    ring[(h + 3) & MASK] = a1;
+    ring[(h + 4) & MASK] = a2;
+    ring[(h + 5) & MASK] = a3;
+    commit(h, format, 4);
+}
+
+extern "C" int mbed_trace_read(uint32_t *buffer, int size) {
+    int n = 0;
+
+    // report the records dropped first, as a record with a null format
+    if (lost != 0 && size >= 3) {
+        IRQ_SAVE();
+        uint32_t l = lost;
+        lost = 0;
+        IRQ_RESTORE();
+        buffer[0] = MBED_TRACE_VALID | (1UL << MBED_TRACE_ARGS_SHIFT)
+                  | (us_ticker_read() & MBED_TRACE_TIME_MASK);
+        buffer[1] = 0;
+        buffer[2] = l;
+        n = 3;
+    }
+
+    uint32_t t = tail;
+    for (;;) {
+        uint32_t header = ring[t & MASK];
+        if (!(header & MBED_TRACE_VALID))
+            break;
+        int len = 2 + ((header >> MBED_TRACE_ARGS_SHIFT) & 0xF);
+        if (n + len > size)
+            break;
+        __DMB();
+        for (int i = 0; i < len; i++) {
+            buffer[n++] = ring[t & MASK];
+            ring[t & MASK] = 0;
+            t++;
+        }
+        __DMB();
+        tail = t;
+    }
+    return n;
+}
+
+namespace mbed {
+
+int trace_drain(FileHandle *out) {
+    uint32_t buffer[64];
+    int total = 0;
+    int n;
+    while ((n = mbed_trace_read(buffer, sizeof(buffer) / sizeof(*buffer))) > 0) {
+        out->write(buffer, n * sizeof(*buffer));
+        total += n;
+    }
+    return total;
+}
+
+} // namespace mbed
@@ -19,6 +19,8 @@
 #include "FilePath.h"
 #include "serial_api.h"
 #include "toolchain.h"
+#include "mbed_printf.h"
+#include "PlatformMutex.h"
 #include <errno.h>
 
 #if defined(__ARMCC_VERSION)
@@ -45,6 +47,11 @@
 #   define PREFIX(x)    x
 #endif
 
+/* Number of files which can be open at once, besides stdin, stdout and stderr */
+#ifndef MBED_OPEN_MAX
+#define MBED_OPEN_MAX   OPEN_MAX
+#endif
+
 using namespace mbed;
 
 #if defined(__MICROLIB) && (__ARMCC_VERSION>5030000)
@@ -64,15 +71,63 @@ extern const char __stderr_name[] = "/stderr";
  * put it in a filehandles array and return the index into that array
  * (or rather index+3, as filehandles 0-2 are stdin/out/err).
  */
-static FileHandle *filehandles[OPEN_MAX];
+static FileHandle *filehandles[MBED_OPEN_MAX];
+
+/* Free slots: those below fh_used which were closed are linked from fh_free
+ * through fh_next, and those from fh_used on were never used */
+static int fh_free = -1;
+static int fh_next[MBED_OPEN_MAX];
+static int fh_used = 0;
+
+/* Protects the allocation of filehandles slots; a slot is then used by
+ * the thread which opened it, and its FileHandle does its own locking */
+static PlatformMutex filehandles_mutex;
+
+static int fh_alloc() {
+    int fh_i;
+    filehandles_mutex.lock();
+    if (fh_free >= 0) {
+        fh_i = fh_free;
+        fh_free = fh_next[fh_i];
+    } else if (fh_used < MBED_OPEN_MAX) {
+        fh_i = fh_used++;
+    } else {
+        fh_i = -1;
+    }
+    filehandles_mutex.unlock();
+    return fh_i;
+}
+
+static void fh_release(int fh_i) {
+    filehandles_mutex.lock();
+    filehandles[fh_i] = NULL;
+    fh_next[fh_i] = fh_free;
+    fh_free = fh_i;
+    filehandles_mutex.unlock();
+}
+
+/* Where stdin, stdout and stderr go; NULL for the stdio serial port */
+static FileHandle *console = NULL;
+
+namespace mbed {
+void set_console(FileHandle *fh) {
+    console = fh;
+}
+}
 
 FileHandle::~FileHandle() {
+    if (console == this) {
+        console = NULL;
+    }
+
     /* Remove all open filehandles for this */
-    for (unsigned int fh_i = 0; fh_i < sizeof(filehandles)/sizeof(*filehandles); fh_i++) {
+    filehandles_mutex.lock();
+    for (int fh_i = 0; fh_i < fh_used; fh_i++) {
         if (filehandles[fh_i] == this) {
-            filehandles[fh_i] = NULL;
+            fh_release(fh_i);
         }
     }
+    filehandles_mutex.unlock();
 }
 
 #if DEVICE_SERIAL
@@ -87,6 +142,26 @@ static void init_serial() {
 #endif
 }
 
+/* Keeps the output of each write to the console together */
+static PlatformMutex console_mutex;
+
+extern "C" int mbed_console_write(const char *data, size_t length) {
+    int n = length;
+    console_mutex.lock();
+    if (console != NULL) {
+        n = console->write(data, length);
+    } else {
+#if DEVICE_SERIAL
+        if (!stdio_uart_inited) init_serial();
+        for (size_t i = 0; i < length; i++) {
+            serial_putc(&stdio_uart, data[i]);
+        }
+#endif
+    }
+    console_mutex.unlock();
+    return n;
+}
+
 static inline int openmode_to_posix(int openmode) {
     int posix = openmode;
 #ifdef __ARMCC_VERSION
@@ -142,16 +217,13 @@ extern "C" FILEHANDLE PREFIX(_open)(const char* name, int openmode) {
     }
     #endif
     
-    // find the first empty slot in filehandles
-    unsigned int fh_i;
-    for (fh_i = 0; fh_i < sizeof(filehandles)/sizeof(*filehandles); fh_i++) {
-        if (filehandles[fh_i] == NULL) break;
-    }
-    if (fh_i >= sizeof(filehandles)/sizeof(*filehandles)) {
+    // take a free slot in filehandles
+    int fh_i = fh_alloc();
+    if (fh_i < 0) {
         return -1;
     }
 
-    FileHandle *res;
+    FileHandle *res = NULL;
 
     /* FILENAME: ":0x12345678" describes a FileLike* */
     if (name[0] == ':') {
@@ -163,19 +235,21 @@ extern "C" FILEHANDLE PREFIX(_open)(const char* name, int openmode) {
     } else {
         FilePath path(name);
 
-        if (!path.exists())
-            return -1;
-        else if (path.isFile()) {
+        if (path.isFile()) {
             res = path.file();
         } else {
             FileSystemLike *fs = path.fileSystem();
-            if (fs == NULL) return -1;
-            int posix_mode = openmode_to_posix(openmode);
-            res = fs->open(path.fileName(), posix_mode); /* NULL if fails */
+            if (fs != NULL) {
+                int posix_mode = openmode_to_posix(openmode);
+                res = fs->open(path.fileName(), posix_mode); /* NULL if fails */
+            }
         }
     }
 
-    if (res == NULL) return -1;
+    if (res == NULL) {
+        fh_release(fh_i);
+        return -1;
+    }
     filehandles[fh_i] = res;
 
     return fh_i + 3; // +3 as filehandles 0-2 are stdin/out/err
@@ -185,8 +259,8 @@ extern "C" int PREFIX(_close)(FILEHANDLE fh) {
     if (fh < 3) return 0;
 
     FileHandle* fhc = filehandles[fh-3];
-    filehandles[fh-3] = NULL;
     if (fhc == NULL) return -1;
+    fh_release(fh-3);
 
     return fhc->close();
 }
@@ -198,13 +272,7 @@ extern "C" int PREFIX(_write)(FILEHANDLE fh, const unsigned char *buffer, unsign
 #endif
     int n; // n is the number of bytes written
     if (fh < 3) {
-#if DEVICE_SERIAL
-        if (!stdio_uart_inited) init_serial();
-        for (unsigned int i = 0; i < length; i++) {
-            serial_putc(&stdio_uart, buffer[i]);
-        }
-#endif
-        n = length;
+        n = mbed_console_write((const char *)buffer, length);
     } else {
         FileHandle* fhc = filehandles[fh-3];
         if (fhc == NULL) return -1;
@@ -226,10 +294,14 @@ extern "C" int PREFIX(_read)(FILEHANDLE fh, unsigned char *buffer, unsigned int
     int n; // n is the number of bytes read
     if (fh < 3) {
         // only read a character at a time from stdin
+        if (console != NULL) {
+            n = console->read(buffer, 1);
+        } else {
 #if DEVICE_SERIAL
-        *buffer = serial_getc(&stdio_uart);
+            *buffer = serial_getc(&stdio_uart);
 #endif
-        n = 1;
+            n = 1;
+        }
     } else {
         FileHandle* fhc = filehandles[fh-3];
         if (fhc == NULL) return -1;
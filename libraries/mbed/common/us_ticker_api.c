@@ -18,14 +18,155 @@
 #include "cmsis.h"
 
 static ticker_event_handler event_handler;
+
+/* Pending events are kept in a pairing heap ordered by timestamp, with head
+   being the earliest event. Every node links to its first child and its next
+   sibling; prev points to the previous sibling, or to the parent for a first
+   child, so that any node can be unlinked without searching the heap.
+   head is the only queued node with a NULL prev.
+   
+   Inserting is O(1). Removing an event re-pairs its children, which is
+   O(log n) amortised but O(n) in the worst case: after a burst of n inserts
+   with no removal, the head has n - 1 children, and the first removal of
+   the head (or its dispatch) melds them all with interrupts disabled. The
+   heap is then shallow, so the cost is paid once per burst. MBED_31
+   reports this first pop. */
 static ticker_event_t *head = NULL;
 
+/* Timestamps are kept on the 64-bit time base, so they never wrap */
+#define TIMESTAMP_BEFORE(a, b)  ((a)->timestamp < (b)->timestamp)
+
+/* The upper 32 bits of the time base are counted in software. An internal
+   event keeps the ticker interrupt firing often enough to never miss a wrap
+   of the 32-bit hardware counter, even when no other event is pending. It
+   also bounds how far ahead the head of the queue can be, so the 32-bit
+   match register can always be programmed with the low word of a deadline. */
+#define OVERFLOW_PERIOD         0x40000000UL
+
+static uint32_t ticker_high = 0;
+static uint32_t ticker_last = 0;
+static ticker_event_t overflow_event;
+static int overflow_event_queued = 0;
+
+/* Link two heap roots together and return the resulting root. The prev and
+   next fields of the returned root are left for the caller to set. */
+static ticker_event_t *meld(ticker_event_t *a, ticker_event_t *b) {
+    if (TIMESTAMP_BEFORE(b, a)) {
+        ticker_event_t *t = a;
+        a = b;
+        b = t;
+    }
+    // b becomes the first child of a
+    b->prev = a;
+    b->next = a->child;
+    if (a->child != NULL) {
+        a->child->prev = b;
+    }
+    a->child = b;
+    return a;
+}
+
+/* Standard two-pass pairing of a list of siblings into a single heap */
+static ticker_event_t *merge_pairs(ticker_event_t *first) {
+    ticker_event_t *acc = NULL;
+    
+    /* First pass: meld siblings in pairs from left to right, collecting the
+       results in reverse order */
+    while (first != NULL) {
+        ticker_event_t *a = first;
+        ticker_event_t *b = a->next;
+        if (b == NULL) {
+            a->next = acc;
+            acc = a;
+            break;
+        }
+        first = b->next;
+        a = meld(a, b);
+        a->next = acc;
+        acc = a;
+    }
+    
+    /* Second pass: meld the pairs from right to left into one heap */
+    ticker_event_t *root = acc;
+    acc = acc->next;
+    while (acc != NULL) {
+        ticker_event_t *next = acc->next;
+        root = meld(root, acc);
+        acc = next;
+    }
+    root->prev = NULL;
+    root->next = NULL;
+    return root;
+}
+
+/* Detach obj's children and return them as a single heap (or NULL) */
+static ticker_event_t *take_children(ticker_event_t *obj) {
+    ticker_event_t *children = obj->child;
+    obj->child = NULL;
+    return (children != NULL) ? merge_pairs(children) : NULL;
+}
+
 void us_ticker_set_handler(ticker_event_handler handler) {
     us_ticker_init();
     
     event_handler = handler;
 }
 
+/* Must be called with interrupts disabled */
+static us_timestamp_t read64(void) {
+    uint32_t now = us_ticker_read();
+    if (now < ticker_last) {
+        ticker_high++;
+    }
+    ticker_last = now;
+    return ((us_timestamp_t)ticker_high << 32) | now;
+}
+
+/* Must be called with interrupts disabled */
+static void insert(ticker_event_t *obj) {
+    us_ticker_init_event(obj);
+    
+    if (head == NULL) {
+        head = obj;
+    } else {
+        head = meld(head, obj);
+        head->prev = NULL;
+        head->next = NULL;
+    }
+    
+    /* if we are the new head, the next interrupt is ours */
+    if (head == obj) {
+        us_ticker_set_interrupt((uint32_t)obj->timestamp);
+    }
+}
+
+/* Must be called with interrupts disabled */
+static void insert_overflow_event(us_timestamp_t timestamp) {
+    overflow_event.timestamp = timestamp;
+    insert(&overflow_event);
+    overflow_event_queued = 1;
+}
+
+/* Callers such as Timer may already have interrupts disabled: keep them so */
+us_timestamp_t us_ticker_read64(void) {
+#ifdef __CORTEX_M
+    uint32_t primask = __get_PRIMASK();
+#endif
+    __disable_irq();
+    
+    us_timestamp_t now = read64();
+    if (!overflow_event_queued) {
+        insert_overflow_event(now + OVERFLOW_PERIOD);
+    }
+    
+#ifdef __CORTEX_M
+    __set_PRIMASK(primask);
+#else
+    __enable_irq();
+#endif
+    return now;
+}
+
 void us_ticker_irq_handler(void) {
     us_ticker_clear_interrupt();
     
@@ -37,53 +178,62 @@ void us_ticker_irq_handler(void) {
             return;
         }
         
-        if ((int)(head->timestamp - us_ticker_read()) <= 0) {
+        if (head->timestamp <= read64()) {
             // This event was in the past:
-            //      point to the following one and execute its handler
+            //      pop it from the heap and execute its handler
             ticker_event_t *p = head;
-            head = head->next;
-            if (event_handler != NULL) {
+            head = take_children(p);
+            if (p == &overflow_event) {
+                // the time base has just been updated, re-arm the next check
+                insert_overflow_event(p->timestamp + OVERFLOW_PERIOD);
+            } else if ((event_handler != NULL) && (p->id != 0)) {
+                // events with an id of 0 only wake the processor up
                 event_handler(p->id); // NOTE: the handler can set new events
             }
         } else {
-            // This event and the following ones in the list are in the future:
+            // This event and all the others in the heap are in the future:
             //      set it as next interrupt and return
-            us_ticker_set_interrupt(head->timestamp);
+            us_ticker_set_interrupt((uint32_t)head->timestamp);
             return;
         }
     }
 }
 
+void us_ticker_init_event(ticker_event_t *obj) {
+    obj->next = NULL;
+    obj->prev = NULL;
+    obj->child = NULL;
+}
+
 void us_ticker_insert_event(ticker_event_t *obj, unsigned int timestamp, uint32_t id) {
     /* disable interrupts for the duration of the function */
     __disable_irq();
     
-    // initialise our data
-    obj->timestamp = timestamp;
+    // extend the timestamp to 64 bits, relative to the current time
+    us_timestamp_t now = read64();
+    int delta = (int)(timestamp - (uint32_t)now);
+    obj->timestamp = (delta > 0) ? now + delta : now;
     obj->id = id;
+    insert(obj);
     
-    /* Go through the list until we either reach the end, or find
-       an element this should come before (which is possibly the
-       head). */
-    ticker_event_t *prev = NULL, *p = head;
-    while (p != NULL) {
-        /* check if we come before p */
-        if ((int)(timestamp - p->timestamp) <= 0) {
-            break;
-        }
-        /* go to the next element */
-        prev = p;
-        p = p->next;
+    if (!overflow_event_queued) {
+        insert_overflow_event(now + OVERFLOW_PERIOD);
     }
-    /* if prev is NULL we're at the head */
-    if (prev == NULL) {
-        head = obj;
-        us_ticker_set_interrupt(timestamp);
-    } else {
-        prev->next = obj;
+    
+    __enable_irq();
+}
+
+void us_ticker_insert_event64(ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id) {
+    /* disable interrupts for the duration of the function */
+    __disable_irq();
+    
+    obj->timestamp = timestamp;
+    obj->id = id;
+    insert(obj);
+    
+    if (!overflow_event_queued) {
+        insert_overflow_event(read64() + OVERFLOW_PERIOD);
     }
-    /* if we're at the end p will be NULL, which is correct */
-    obj->next = p;
     
     __enable_irq();
 }
@@ -91,24 +241,33 @@ void us_ticker_insert_event(ticker_event_t *obj, unsigned int timestamp, uint32_
 void us_ticker_remove_event(ticker_event_t *obj) {
     __disable_irq();
     
-    // remove this object from the list
     if (head == obj) {
-        // first in the list, so just drop me
-        head = obj->next;
+        // first in the heap, so just drop me
+        head = take_children(obj);
+        if (head != NULL) {
+            us_ticker_set_interrupt((uint32_t)head->timestamp);
+        }
+    } else if (obj->prev != NULL) {
+        // unlink me from my parent or previous sibling
+        if (obj->prev->child == obj) {
+            obj->prev->child = obj->next;
+        } else {
+            obj->prev->next = obj->next;
+        }
         if (obj->next != NULL) {
-            us_ticker_set_interrupt(head->timestamp);
+            obj->next->prev = obj->prev;
         }
-    } else {
-        // find the object before me, then drop me
-        ticker_event_t* p = head;
-        while (p != NULL) {
-            if (p->next == obj) {
-                p->next = obj->next;
-                break;
-            }
-            p = p->next;
+        
+        // my children can not come before the head, so it stays the head
+        ticker_event_t *children = take_children(obj);
+        if (children != NULL) {
+            head = meld(head, children);
         }
     }
+    // otherwise the event is not pending
+    
+    obj->next = NULL;
+    obj->prev = NULL;
     
     __enable_irq();
 }
@@ -40,6 +40,18 @@ void gpio_irq_set (gpio_irq_t *obj, gpio_irq_event event, uint32_t enable);
 void gpio_irq_enable(gpio_irq_t *obj);
 void gpio_irq_disable(gpio_irq_t *obj);
 
+#if DEVICE_INTERRUPTIN_GROUP
+
+typedef struct gpio_irq_group_s gpio_irq_group_t;
+
+typedef void (*gpio_irq_group_handler)(uint32_t id, uint32_t rise, uint32_t fall);
+
+int  gpio_irq_group_init(gpio_irq_group_t *obj, PortName port, uint32_t mask, gpio_irq_group_handler handler, uint32_t id);
+void gpio_irq_group_free(gpio_irq_group_t *obj);
+void gpio_irq_group_set (gpio_irq_group_t *obj, gpio_irq_event event, uint32_t enable);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
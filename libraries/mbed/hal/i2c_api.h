@@ -28,7 +28,8 @@ typedef struct i2c_s i2c_t;
 
 enum {
   I2C_ERROR_NO_SLAVE = -1,
-  I2C_ERROR_BUS_BUSY = -2
+  I2C_ERROR_BUS_BUSY = -2,
+  I2C_ERROR_NACK     = -3
 };
 
 void i2c_init         (i2c_t *obj, PinName sda, PinName scl);
@@ -41,6 +42,19 @@ void i2c_reset        (i2c_t *obj);
 int  i2c_byte_read    (i2c_t *obj, int last);
 int  i2c_byte_write   (i2c_t *obj, int data);
 
+#if DEVICE_I2C_ASYNCH
+typedef void (*i2c_transfer_handler)(uint32_t id, int result);
+
+/* Start a master transaction in the background
+ * Writes tx_length bytes, then, after a repeated start, reads rx_length
+ * bytes; either length may be 0. A transaction started without a stop
+ * keeps the bus, and the next one begins with a repeated start.
+ * handler(id, result) is called from the I2C interrupt once the
+ * transaction is over, with result 0 on success or an I2C_ERROR_ code.
+ **/
+void i2c_transfer_asynch(i2c_t *obj, int address, const char *tx, int tx_length, char *rx, int rx_length, int stop, i2c_transfer_handler handler, uint32_t id);
+#endif
+
 #if DEVICE_I2CSLAVE
 void i2c_slave_mode   (i2c_t *obj, int enable_slave);
 int  i2c_slave_receive(i2c_t *obj);
@@ -28,6 +28,17 @@ typedef struct port_s port_t;
 
 PinName port_pin(PortName port, int pin_n);
 
+#if DEVICE_PORT_PINMAP
+/* Find the port a pin belongs to, the inverse of port_pin()
+ * The bus classes then write their pins with port_write(), which must change
+ * the pins of its mask without a read-modify-write of the other pins.
+ * @param pin  The pin to look up
+ * @param port Set to the port of the pin
+ * @return The bit of the pin within its port, or -1 if it is not a port pin
+ **/
+int pin_port(PinName pin, PortName *port);
+#endif
+
 void port_init (port_t *obj, PortName port, int mask, PinDirection dir);
 void port_mode (port_t *obj, PinMode mode);
 void port_dir  (port_t *obj, PinDirection dir);
@@ -36,6 +36,33 @@ int  spi_slave_read   (spi_t *obj);
 void spi_slave_write  (spi_t *obj, int value);
 int  spi_busy         (spi_t *obj);
 
+#if DEVICE_SPI_BLOCK
+/* Transfer a block of frames as master, keeping the transmit FIFO full
+ * Frames are one byte each for formats of up to 8 bits, two bytes otherwise.
+ * @param tx     The frames to send, or NULL to send all ones
+ * @param rx     Buffer for the received frames, or NULL to discard them
+ * @param length The number of frames
+ **/
+void spi_master_block_write(spi_t *obj, const void *tx, void *rx, int length);
+#endif
+
+#if DEVICE_SPI_DMA
+typedef void (*spi_dma_handler)(uint32_t id);
+
+/* Start a block transfer as master in the background, as for
+ * spi_master_block_write(); handler(id) is called from the DMA interrupt
+ * when the last frame has been received. The buffers must stay valid, and
+ * the SPI unused, until then.
+ * @return 0 if the transfer was started, -1 if one is still running on the SPI
+ **/
+int  spi_master_transfer_dma(spi_t *obj, const void *tx, void *rx, int length, spi_dma_handler handler, uint32_t id);
+
+/* Whether a transfer started with spi_master_transfer_dma() on the SPI has
+ * not called its handler yet
+ **/
+int  spi_master_dma_busy(spi_t *obj);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,15 +22,20 @@
 extern "C" {
 #endif
 
+typedef uint64_t us_timestamp_t;
+
 uint32_t us_ticker_read(void);
+us_timestamp_t us_ticker_read64(void);
 
 typedef void (*ticker_event_handler)(uint32_t id);
 void us_ticker_set_handler(ticker_event_handler handler);
 
 typedef struct ticker_event_s {
-    uint32_t timestamp;
+    us_timestamp_t timestamp;
     uint32_t id;
-    struct ticker_event_s *next;
+    struct ticker_event_s *next;    // next sibling in the event queue
+    struct ticker_event_s *prev;    // previous sibling, or parent for a first child
+    struct ticker_event_s *child;   // first child in the event queue
 } ticker_event_t;
 
 void us_ticker_init(void);
@@ -39,7 +44,11 @@ void us_ticker_disable_interrupt(void);
 void us_ticker_clear_interrupt(void);
 void us_ticker_irq_handler(void);
 
+/* Events inserted with an id of 0 do not call the handler, they only wake
+   the processor up from sleep() at the given time */
+void us_ticker_init_event(ticker_event_t *obj);
 void us_ticker_insert_event(ticker_event_t *obj, unsigned int timestamp, uint32_t id);
+void us_ticker_insert_event64(ticker_event_t *obj, us_timestamp_t timestamp, uint32_t id);
 void us_ticker_remove_event(ticker_event_t *obj);
 
 #ifdef __cplusplus
@@ -19,8 +19,10 @@
 #define DEVICE_PORTIN           1
 #define DEVICE_PORTOUT          1
 #define DEVICE_PORTINOUT        1
+#define DEVICE_PORT_PINMAP      1
 
 #define DEVICE_INTERRUPTIN      1
+#define DEVICE_INTERRUPTIN_GROUP 1
 
 #define DEVICE_ANALOGIN         1
 #define DEVICE_ANALOGOUT        1
@@ -29,9 +31,12 @@
 
 #define DEVICE_I2C              1
 #define DEVICE_I2CSLAVE         1
+#define DEVICE_I2C_ASYNCH       1
 
 #define DEVICE_SPI              1
 #define DEVICE_SPISLAVE         1
+#define DEVICE_SPI_BLOCK        1
+#define DEVICE_SPI_DMA          1
 
 #define DEVICE_CAN              1
 
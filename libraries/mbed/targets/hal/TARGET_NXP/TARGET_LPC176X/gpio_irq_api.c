@@ -24,6 +24,22 @@
 static uint32_t channel_ids[CHANNEL_NUM] = {0};
 static gpio_irq_handler irq_handler;
 
+// One group of pins per interrupt capable port (GPIO0 and GPIO2)
+#define GROUP_NUM       2
+
+static uint32_t group_ids[GROUP_NUM] = {0};
+static uint32_t group_masks[GROUP_NUM] = {0};
+static gpio_irq_group_handler group_handler;
+
+static inline void handle_group(int index, uint32_t *rise, uint32_t *fall) {
+    uint32_t mask = group_masks[index];
+    if ((*rise | *fall) & mask) {
+        group_handler(group_ids[index], *rise & mask, *fall & mask);
+        *rise &= ~mask;
+        *fall &= ~mask;
+    }
+}
+
 static void handle_interrupt_in(void) {
     // Read in all current interrupt registers. We do this once as the
     // GPIO interrupt registers are on the APB bus, and this is slow.
@@ -33,13 +49,25 @@ static void handle_interrupt_in(void) {
     uint32_t fall2 = LPC_GPIOINT->IO2IntStatF;
     uint8_t bitloc;
     
+    // Clear all the interrupts we are about to handle, with a single write
+    // per port. An edge happening while a handler runs will be seen again.
+    if (rise0 | fall0)
+        LPC_GPIOINT->IO0IntClr = rise0 | fall0;
+    if (rise2 | fall2)
+        LPC_GPIOINT->IO2IntClr = rise2 | fall2;
+    
+    // Pin groups get all their pending edges in a single call
+    if (group_masks[0])
+        handle_group(0, &rise0, &fall0);
+    if (group_masks[1])
+        handle_group(1, &rise2, &fall2);
+    
     while(rise0 > 0) {      //Continue as long as there are interrupts pending
         bitloc = 31 - __CLZ(rise0); //CLZ returns number of leading zeros, 31 minus that is location of first pending interrupt
         if (channel_ids[bitloc] != 0)
             irq_handler(channel_ids[bitloc], IRQ_RISE); //Run that interrupt
         
-        //Both clear the interrupt with clear register, and remove it from our local copy of the interrupt pending register
-        LPC_GPIOINT->IO0IntClr = 1 << bitloc;
+        //Remove it from our local copy of the interrupt pending register
         rise0 -= 1<<bitloc;
     }
     
@@ -48,8 +76,7 @@ static void handle_interrupt_in(void) {
         if (channel_ids[bitloc] != 0)
             irq_handler(channel_ids[bitloc], IRQ_FALL); //Run that interrupt
         
-        //Both clear the interrupt with clear register, and remove it from our local copy of the interrupt pending register
-        LPC_GPIOINT->IO0IntClr = 1 << bitloc;
+        //Remove it from our local copy of the interrupt pending register
         fall0 -= 1<<bitloc;
     }
     
@@ -61,8 +88,7 @@ static void handle_interrupt_in(void) {
             if (channel_ids[bitloc+32] != 0)
                 irq_handler(channel_ids[bitloc+32], IRQ_RISE); //Run that interrupt
         
-        //Both clear the interrupt with clear register, and remove it from our local copy of the interrupt pending register
-        LPC_GPIOINT->IO2IntClr = 1 << bitloc;
+        //Remove it from our local copy of the interrupt pending register
         rise2 -= 1<<bitloc;
     }
     
@@ -73,8 +99,7 @@ static void handle_interrupt_in(void) {
             if (channel_ids[bitloc+32] != 0)
                 irq_handler(channel_ids[bitloc+32], IRQ_FALL); //Run that interrupt
         
-        //Both clear the interrupt with clear register, and remove it from our local copy of the interrupt pending register
-        LPC_GPIOINT->IO2IntClr = 1 << bitloc;
+        //Remove it from our local copy of the interrupt pending register
         fall2 -= 1<<bitloc;
     }
 }
@@ -151,6 +176,56 @@ void gpio_irq_set(gpio_irq_t *obj, gpio_irq_event event, uint32_t enable) {
     }
 }
 
+int gpio_irq_group_init(gpio_irq_group_t *obj, PortName port, uint32_t mask, gpio_irq_group_handler handler, uint32_t id) {
+    // Interrupts available only on GPIO0 and GPIO2
+    if (port != Port0 && port != Port2) {
+        error("pins on this port cannot generate interrupts\n");
+    }
+    
+    int index = (port == Port0) ? 0 : 1;
+    if (group_masks[index] != 0) {
+        error("only one interrupt group per port is supported\n");
+    }
+    
+    group_handler = handler;
+    group_ids[index] = id;
+    group_masks[index] = mask;
+    obj->index = index;
+    obj->mask = mask;
+    
+    NVIC_SetVector(EINT3_IRQn, (uint32_t)handle_interrupt_in);
+    NVIC_EnableIRQ(EINT3_IRQn);
+    return 0;
+}
+
+void gpio_irq_group_free(gpio_irq_group_t *obj) {
+    gpio_irq_group_set(obj, IRQ_RISE, 0);
+    gpio_irq_group_set(obj, IRQ_FALL, 0);
+    group_masks[obj->index] = 0;
+    group_ids[obj->index] = 0;
+}
+
+void gpio_irq_group_set(gpio_irq_group_t *obj, gpio_irq_event event, uint32_t enable) {
+    __IO uint32_t *clr, *en;
+    if (obj->index == 0) {
+        clr = &LPC_GPIOINT->IO0IntClr;
+        en = (event == IRQ_RISE) ? &LPC_GPIOINT->IO0IntEnR : &LPC_GPIOINT->IO0IntEnF;
+    } else {
+        clr = &LPC_GPIOINT->IO2IntClr;
+        en = (event == IRQ_RISE) ? &LPC_GPIOINT->IO2IntEnR : &LPC_GPIOINT->IO2IntEnF;
+    }
+    
+    // ensure nothing is pending
+    *clr = obj->mask;
+    
+    // enable the pin interrupts
+    if (enable) {
+        *en |= obj->mask;
+    } else {
+        *en &= ~obj->mask;
+    }
+}
+
 void gpio_irq_enable(gpio_irq_t *obj) {
     NVIC_EnableIRQ(EINT3_IRQn);
 }
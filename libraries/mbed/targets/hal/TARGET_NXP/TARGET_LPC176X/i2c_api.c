@@ -315,6 +315,148 @@ int i2c_byte_write(i2c_t *obj, int data) {
     return ack;
 }
 
+typedef struct {
+    LPC_I2C_TypeDef *i2c;
+    int address;
+    const char *tx;
+    int tx_length;
+    char *rx;
+    int rx_length;
+    int pos;
+    int reading;
+    int stop;
+    i2c_transfer_handler handler;
+    uint32_t id;
+} i2c_transfer_t;
+
+static i2c_transfer_t i2c_transfers[3];
+
+static const IRQn_Type i2c_irq_n[3] = {I2C0_IRQn, I2C1_IRQn, I2C2_IRQn};
+
+static inline int i2c_index(i2c_t *obj) {
+    switch ((int)obj->i2c) {
+        case I2C_0: return 0;
+        case I2C_1: return 1;
+        default:    return 2;
+    }
+}
+
+static void i2c_transfer_end(int index, i2c_t *obj, int result) {
+    i2c_transfer_t *t = &i2c_transfers[index];
+    
+    if (result != 0 || t->stop) {
+        i2c_conset(obj, 0, 1, 0, 0);
+        i2c_clear_SI(obj);
+    }
+    // without a stop SI stays set, holding the bus until the next start
+    NVIC_DisableIRQ(i2c_irq_n[index]);
+    t->handler(t->id, result);
+}
+
+static void i2c_transfer_irq(int index) {
+    i2c_transfer_t *t = &i2c_transfers[index];
+    i2c_t obj_s = {t->i2c};
+    i2c_t *obj = &obj_s;
+    
+    switch (i2c_status(obj)) {
+        case 0x08:  // start transmitted
+        case 0x10:  // repeated start transmitted
+            i2c_conclr(obj, 1, 0, 0, 0);
+            if (!t->reading && t->tx_length == 0 && t->rx_length > 0) {
+                t->reading = 1;
+            }
+            I2C_DAT(obj) = t->reading ? (t->address | 0x01) : (t->address & 0xFE);
+            i2c_clear_SI(obj);
+            break;
+        
+        case 0x18:  // SLA+W transmitted, ACK received
+        case 0x28:  // data transmitted, ACK received
+            if (t->pos < t->tx_length) {
+                I2C_DAT(obj) = t->tx[t->pos++];
+                i2c_clear_SI(obj);
+            } else if (t->rx_length > 0) {
+                t->reading = 1;
+                t->pos = 0;
+                i2c_conset(obj, 1, 0, 0, 0);
+                i2c_clear_SI(obj);
+            } else {
+                i2c_transfer_end(index, obj, 0);
+            }
+            break;
+        
+        case 0x40:  // SLA+R transmitted, ACK received
+            if (t->rx_length > 1) {
+                i2c_conset(obj, 0, 0, 0, 1);
+            } else {
+                i2c_conclr(obj, 0, 0, 0, 1);
+            }
+            i2c_clear_SI(obj);
+            break;
+        
+        case 0x50:  // data received, ACK returned
+            t->rx[t->pos++] = I2C_DAT(obj) & 0xFF;
+            if (t->pos >= t->rx_length - 1) {
+                i2c_conclr(obj, 0, 0, 0, 1);
+            }
+            i2c_clear_SI(obj);
+            break;
+        
+        case 0x58:  // data received, NOT ACK returned: last byte
+            t->rx[t->pos++] = I2C_DAT(obj) & 0xFF;
+            i2c_transfer_end(index, obj, 0);
+            break;
+        
+        case 0x20:  // SLA+W transmitted, NOT ACK received
+        case 0x48:  // SLA+R transmitted, NOT ACK received
+            i2c_transfer_end(index, obj, I2C_ERROR_NO_SLAVE);
+            break;
+        
+        case 0x30:  // data transmitted, NOT ACK received
+            i2c_transfer_end(index, obj, I2C_ERROR_NACK);
+            break;
+        
+        case 0x38:  // arbitration lost: the bus is released
+            i2c_clear_SI(obj);
+            t->stop = 0;
+            i2c_transfer_end(index, obj, I2C_ERROR_BUS_BUSY);
+            break;
+        
+        default:
+            i2c_transfer_end(index, obj, I2C_ERROR_BUS_BUSY);
+            break;
+    }
+}
+
+static void i2c0_irq(void) {i2c_transfer_irq(0);}
+static void i2c1_irq(void) {i2c_transfer_irq(1);}
+static void i2c2_irq(void) {i2c_transfer_irq(2);}
+
+void i2c_transfer_asynch(i2c_t *obj, int address, const char *tx, int tx_length, char *rx, int rx_length, int stop, i2c_transfer_handler handler, uint32_t id) {
+    static void (* const vectors[3])(void) = {i2c0_irq, i2c1_irq, i2c2_irq};
+    int index = i2c_index(obj);
+    i2c_transfer_t *t = &i2c_transfers[index];
+    
+    t->i2c = obj->i2c;
+    t->address = address;
+    t->tx = tx;
+    t->tx_length = tx_length;
+    t->rx = rx;
+    t->rx_length = rx_length;
+    t->pos = 0;
+    t->reading = 0;
+    t->stop = stop;
+    t->handler = handler;
+    t->id = id;
+    
+    // as in i2c_start(): clearing SI after STA generates the (repeated) start
+    i2c_conclr(obj, 1, 0, 0, 1);
+    i2c_conset(obj, 1, 0, 0, 0);
+    i2c_clear_SI(obj);
+    
+    NVIC_SetVector(i2c_irq_n[index], (uint32_t)vectors[index]);
+    NVIC_EnableIRQ(i2c_irq_n[index]);
+}
+
 void i2c_slave_mode(i2c_t *obj, int enable_slave) {
     if (enable_slave != 0) {
         i2c_conclr(obj, 1, 1, 1, 0);
@@ -31,10 +31,16 @@ struct gpio_irq_s {
     uint32_t ch;
 };
 
+struct gpio_irq_group_s {
+    uint32_t index;
+    uint32_t mask;
+};
+
 struct port_s {
     __IO uint32_t *reg_dir;
     __IO uint32_t *reg_out;
     __I  uint32_t *reg_in;
+    __IO uint32_t *reg_mask;
     PortName port;
     uint32_t mask;
 };
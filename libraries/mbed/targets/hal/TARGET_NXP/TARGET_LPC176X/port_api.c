@@ -21,6 +21,14 @@ PinName port_pin(PortName port, int pin_n) {
     return (PinName)(LPC_GPIO0_BASE + ((port << PORT_SHIFT) | pin_n));
 }
 
+int pin_port(PinName pin, PortName *port) {
+    if (pin == (PinName)NC)
+        return -1;
+    uint32_t n = (uint32_t)pin - LPC_GPIO0_BASE;
+    *port = (PortName)(n >> PORT_SHIFT);
+    return n & ((1 << PORT_SHIFT) - 1);
+}
+
 void port_init(port_t *obj, PortName port, int mask, PinDirection dir) {
     obj->port = port;
     obj->mask = mask;
@@ -33,6 +41,7 @@ void port_init(port_t *obj, PortName port, int mask, PinDirection dir) {
     obj->reg_out = &port_reg->FIOPIN;
     obj->reg_in  = &port_reg->FIOPIN;
     obj->reg_dir  = &port_reg->FIODIR;
+    obj->reg_mask = &port_reg->FIOMASK;
     
     uint32_t i;
     // The function is set per pin: reuse gpio logic
@@ -63,7 +72,16 @@ void port_dir(port_t *obj, PinDirection dir) {
 }
 
 void port_write(port_t *obj, int value) {
-    *obj->reg_out = (*obj->reg_in & ~obj->mask) | (value & obj->mask);
+    // One store to FIOPIN, with FIOMASK keeping it off the other pins of the
+    // port: the pins change together, and no read-modify-write can undo the
+    // changes of an interrupt handler. The handlers must not see the mask.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t mask = *obj->reg_mask;
+    *obj->reg_mask = ~obj->mask;
+    *obj->reg_out = value;
+    *obj->reg_mask = mask;
+    __set_PRIMASK(primask);
 }
 
 int port_read(port_t *obj) {
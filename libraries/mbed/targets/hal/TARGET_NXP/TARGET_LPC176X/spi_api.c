@@ -220,3 +220,184 @@ void spi_slave_write(spi_t *obj, int value) {
 int spi_busy(spi_t *obj) {
     return ssp_busy(obj);
 }
+
+#define SSP_FIFO_DEPTH  8
+
+void spi_master_block_write(spi_t *obj, const void *tx, void *rx, int length) {
+    int wide = (obj->spi->CR0 & 0xF) > 7;
+    int sent = 0, received = 0;
+    
+    // discard anything left over in the receive FIFO
+    while (ssp_readable(obj)) {
+        (void)obj->spi->DR;
+    }
+    
+    while (received < length) {
+        // keep the transmit FIFO full, but never have more frames in flight
+        // than the receive FIFO can hold
+        while (sent < length && (sent - received) < SSP_FIFO_DEPTH && ssp_writeable(obj)) {
+            int value = 0xFFFF;
+            if (tx != NULL) {
+                value = wide ? ((const uint16_t *)tx)[sent] : ((const uint8_t *)tx)[sent];
+            }
+            obj->spi->DR = value;
+            sent++;
+        }
+        while (ssp_readable(obj)) {
+            int value = obj->spi->DR;
+            if (rx != NULL) {
+                if (wide) {
+                    ((uint16_t *)rx)[received] = value;
+                } else {
+                    ((uint8_t *)rx)[received] = value;
+                }
+            }
+            received++;
+        }
+    }
+}
+
+/* GPDMA channels 4 and 5 serve SSP0, 6 and 7 serve SSP1; the receive
+ * channel of each pair has the higher priority, and its terminal count
+ * interrupt ends the transfer
+ */
+#define DMA_RX_CHANNEL(i)   (4 + 2 * (i))
+#define DMA_TX_CHANNEL(i)   (5 + 2 * (i))
+#define DMA_CHANNEL(n)      ((LPC_GPDMACH_TypeDef *)(LPC_GPDMACH0_BASE + 0x20 * (n)))
+#define DMA_MAX_TRANSFER    0xFFF
+
+// GPDMA channel control and configuration bits
+#define DMA_BURST_4         1
+#define DMA_SBSIZE(b)       ((b) << 12)
+#define DMA_DBSIZE(b)       ((b) << 15)
+#define DMA_SWIDTH(w)       ((w) << 18)
+#define DMA_DWIDTH(w)       ((w) << 21)
+#define DMA_SI              (1UL << 26)
+#define DMA_DI              (1UL << 27)
+#define DMA_I               (1UL << 31)
+#define DMA_E               (1UL << 0)
+#define DMA_SRCPERIPH(p)    ((p) << 1)
+#define DMA_DESTPERIPH(p)   ((p) << 6)
+#define DMA_M2P             (1UL << 11)
+#define DMA_P2M             (2UL << 11)
+#define DMA_IE              (1UL << 14)
+#define DMA_ITC             (1UL << 15)
+
+// SSP DMA control register
+#define SSP_RXDMAE          (1 << 0)
+#define SSP_TXDMAE          (1 << 1)
+
+typedef struct {
+    LPC_SSP_TypeDef *spi;
+    const uint8_t *tx;
+    uint8_t *rx;
+    int remaining;
+    int wide;
+    spi_dma_handler handler;
+    uint32_t id;
+    volatile int busy;      // until the handler is called
+} spi_dma_t;
+
+static spi_dma_t spi_dma[2];
+static const uint16_t dma_fill = 0xFFFF;
+static uint16_t dma_discard;
+
+static void spi_dma_start(int i) {
+    spi_dma_t *t = &spi_dma[i];
+    LPC_GPDMACH_TypeDef *rx_ch = DMA_CHANNEL(DMA_RX_CHANNEL(i));
+    LPC_GPDMACH_TypeDef *tx_ch = DMA_CHANNEL(DMA_TX_CHANNEL(i));
+    
+    int frames = (t->remaining > DMA_MAX_TRANSFER) ? DMA_MAX_TRANSFER : t->remaining;
+    uint32_t control = frames
+                     | DMA_SBSIZE(DMA_BURST_4) | DMA_DBSIZE(DMA_BURST_4)
+                     | DMA_SWIDTH(t->wide) | DMA_DWIDTH(t->wide);
+    
+    // the request lines are SSP0 Tx/Rx = 0/1 and SSP1 Tx/Rx = 2/3
+    rx_ch->DMACCSrcAddr  = (uint32_t)&t->spi->DR;
+    rx_ch->DMACCDestAddr = (t->rx != NULL) ? (uint32_t)t->rx : (uint32_t)&dma_discard;
+    rx_ch->DMACCLLI      = 0;
+    rx_ch->DMACCControl  = control | DMA_I | ((t->rx != NULL) ? DMA_DI : 0);
+    rx_ch->DMACCConfig   = DMA_E | DMA_SRCPERIPH(2 * i + 1) | DMA_P2M | DMA_IE | DMA_ITC;
+    
+    tx_ch->DMACCSrcAddr  = (t->tx != NULL) ? (uint32_t)t->tx : (uint32_t)&dma_fill;
+    tx_ch->DMACCDestAddr = (uint32_t)&t->spi->DR;
+    tx_ch->DMACCLLI      = 0;
+    tx_ch->DMACCControl  = control | ((t->tx != NULL) ? DMA_SI : 0);
+    tx_ch->DMACCConfig   = DMA_E | DMA_DESTPERIPH(2 * i) | DMA_M2P | DMA_IE;
+    
+    if (t->tx != NULL) t->tx += frames << t->wide;
+    if (t->rx != NULL) t->rx += frames << t->wide;
+    t->remaining -= frames;
+}
+
+static void spi_dma_irq(void) {
+    int i;
+    for (i = 0; i < 2; i++) {
+        uint32_t channels = (1 << DMA_RX_CHANNEL(i)) | (1 << DMA_TX_CHANNEL(i));
+        uint32_t done = LPC_GPDMA->DMACIntTCStat & (1 << DMA_RX_CHANNEL(i));
+        uint32_t failed = LPC_GPDMA->DMACIntErrStat & channels;
+        if (!done && !failed)
+            continue;
+        
+        LPC_GPDMA->DMACIntTCClear = channels;
+        LPC_GPDMA->DMACIntErrClr = channels;
+        
+        spi_dma_t *t = &spi_dma[i];
+        if (!failed && t->remaining > 0) {
+            spi_dma_start(i);
+        } else {
+            DMA_CHANNEL(DMA_RX_CHANNEL(i))->DMACCConfig = 0;
+            DMA_CHANNEL(DMA_TX_CHANNEL(i))->DMACCConfig = 0;
+            t->spi->DMACR = 0;
+            t->busy = 0;
+            t->handler(t->id);
+        }
+    }
+}
+
+int spi_master_transfer_dma(spi_t *obj, const void *tx, void *rx, int length, spi_dma_handler handler, uint32_t id) {
+    static int dma_inited = 0;
+    if (!dma_inited) {
+        LPC_SC->PCONP |= 1 << 29;
+        LPC_GPDMA->DMACConfig = 1;
+        NVIC_SetVector(DMA_IRQn, (uint32_t)spi_dma_irq);
+        NVIC_EnableIRQ(DMA_IRQn);
+        dma_inited = 1;
+    }
+    
+    int i = (obj->spi == LPC_SSP0) ? 0 : 1;
+    uint32_t channels = (1 << DMA_RX_CHANNEL(i)) | (1 << DMA_TX_CHANNEL(i));
+    spi_dma_t *t = &spi_dma[i];
+    // the channels are also disabled between two pieces of a transfer
+    if (t->busy)
+        return -1;
+    
+    while (ssp_readable(obj)) {
+        (void)obj->spi->DR;
+    }
+    
+    t->spi = obj->spi;
+    t->tx = (const uint8_t *)tx;
+    t->rx = (uint8_t *)rx;
+    t->remaining = length;
+    t->wide = (obj->spi->CR0 & 0xF) > 7;
+    t->handler = handler;
+    t->id = id;
+    
+    if (length <= 0) {
+        handler(id);
+        return 0;
+    }
+    
+    t->busy = 1;
+    LPC_GPDMA->DMACIntTCClear = channels;
+    LPC_GPDMA->DMACIntErrClr = channels;
+    spi_dma_start(i);
+    obj->spi->DMACR = SSP_RXDMAE | SSP_TXDMAE;
+    return 0;
+}
+
+int spi_master_dma_busy(spi_t *obj) {
+    int i = (obj->spi == LPC_SSP0) ? 0 : 1;
+    return spi_dma[i].busy;
+}
@@ -187,6 +187,39 @@ __attribute__((used)) void _mutex_release (OS_ID *mutex) {
   }
 }
 
+#elif defined (__GNUC__)
+ osMutexDef(malloc_mutex);
+ static osMutexId malloc_mutex_id;
+
+ /*--------------------------- malloc_mutex_init -----------------------------*/
+
+void malloc_mutex_init (void) {
+  /* Create the heap mutex, called before the kernel is started. */
+  malloc_mutex_id = osMutexCreate (osMutex(malloc_mutex));
+}
+
+
+/*--------------------------- __malloc_lock ---------------------------------*/
+
+struct _reent;
+
+void __malloc_lock (struct _reent *r) {
+  /* Lock the newlib heap. The RTX mutex is recursive, as realloc needs. */
+  if ((__get_IPSR () == 0) && osKernelRunning ()) {
+    osMutexWait (malloc_mutex_id, osWaitForever);
+  }
+}
+
+
+/*--------------------------- __malloc_unlock -------------------------------*/
+
+void __malloc_unlock (struct _reent *r) {
+  /* Unlock the newlib heap. */
+  if ((__get_IPSR () == 0) && osKernelRunning ()) {
+    osMutexRelease (malloc_mutex_id);
+  }
+}
+
 #endif
 
 
@@ -332,6 +365,7 @@ __attribute ((noreturn)) void __cs3_start_c (void){
   __libc_init_array ();
 
   osKernelInitialize();
+  malloc_mutex_init();
   set_main_stack();
   osThreadCreate(&os_thread_def_main, NULL);
   osKernelStart();
@@ -354,6 +388,7 @@ __attribute__((naked)) void software_init_hook (void) {
     "mov  r0,r4\n"
     "mov  r1,r5\n"
     "bl   osKernelInitialize\n"
+    "bl   malloc_mutex_init\n"
     "bl   set_main_stack\n"
     "ldr  r0,=os_thread_def_main\n"
     "movs r1,#0\n"
@@ -125,6 +125,15 @@
  #define OS_TICK        1000
 #endif
 
+//   <q>Tickless idle
+//   <i> Stops the system tick while the idle thread runs and sleeps until
+//   <i> the next thread or timer timeout, using the us_ticker to wake up.
+//   <i> Note that sleeping disconnects the mbed interface (LocalFileSystem).
+//   <i> Default: 0 (disabled)
+#ifndef OS_TICKLESS
+ #define OS_TICKLESS    0
+#endif
+
 // </h>
 
 // <h>System Configuration
@@ -210,6 +219,54 @@
 /*----------------------------------------------------------------------------
  *      OS Idle daemon
  *---------------------------------------------------------------------------*/
+#if OS_TICKLESS
+#include "cmsis.h"
+#include "us_ticker_api.h"
+#include "sleep_api.h"
+
+extern uint32_t rt_psh_pending(void);
+
+/* Wakes the idle thread at the next timeout; an id of 0 only wakes the core */
+static ticker_event_t os_wakeup_event;
+
+void os_idle_demon (void) {
+  /* The idle demon is a system thread, running when no other thread is      */
+  /* ready to run.                                                           */
+  
+  /* Stop the system tick, sleep until the next timeout or interrupt, then
+     account the elapsed ticks to the kernel before resuming it.
+  */
+  uint32_t ticks, first, elapsed;
+  us_timestamp_t start;
+  
+  for (;;) {
+    ticks = os_suspend();
+    if (ticks == 0) {
+      os_resume(0);
+      continue;
+    }
+    
+    /* SysTick keeps counting with its interrupt masked: wake up on one of
+       its period boundaries, so that the tick phase is preserved */
+    first = (uint32_t)(((uint64_t)SysTick->VAL * OS_TICK) / (OS_TRV + 1));
+    start = us_ticker_read64();
+    us_ticker_insert_event64(&os_wakeup_event, start + first + (us_timestamp_t)(ticks - 1) * OS_TICK, 0);
+    
+    /* A pending interrupt still wakes the core from WFI with PRIMASK set,
+       which closes the race with ISRs signalling a thread before we sleep */
+    __disable_irq();
+    if (!rt_psh_pending()) {
+      sleep();
+    }
+    __enable_irq();
+    
+    us_ticker_remove_event(&os_wakeup_event);
+    elapsed = (uint32_t)(us_ticker_read64() - start);
+    os_resume((elapsed < first) ? 0 : 1 + (elapsed - first) / OS_TICK);
+  }
+}
+
+#else
 void os_idle_demon (void) {
   /* The idle demon is a system thread, running when no other thread is      */
   /* ready to run.                                                           */
@@ -217,11 +274,13 @@ void os_idle_demon (void) {
   /* Sleep: ideally, we should put the chip to sleep.
      Unfortunately, this usually requires disconnecting the interface chip (debugger).
      This can be done, but it would break the local file system.
+     Define OS_TICKLESS to sleep between timeouts instead.
   */
   for (;;) {
       // sleep();
   }
 }
+#endif
 
 /*----------------------------------------------------------------------------
  *      RTX Errors
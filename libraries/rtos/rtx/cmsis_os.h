@@ -321,6 +321,15 @@ osStatus osKernelStart (void);
 /// \return 0 RTOS is not started, 1 RTOS is started.
 int32_t osKernelRunning(void);
 
+/// Suspend the RTOS Kernel scheduler and stop the system tick (RTX extension).
+/// \return number of ticks until the next thread or timer timeout, 0xFFFF if none is pending.
+/// \note Intended to be called from the idle thread only, followed by \b os_resume.
+uint32_t os_suspend (void);
+
+/// Resume the RTOS Kernel scheduler after \b os_suspend (RTX extension).
+/// \param[in]     sleep_time    number of ticks that elapsed while suspended.
+void os_resume (uint32_t sleep_time);
+
 
 //  ==== Thread Management ====
 
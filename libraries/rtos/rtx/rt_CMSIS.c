@@ -456,6 +456,8 @@ uint8_t os_running;                             // Kernel Running flag
 SVC_0_1(svcKernelInitialize, osStatus, RET_osStatus)
 SVC_0_1(svcKernelStart,      osStatus, RET_osStatus)
 SVC_0_1(svcKernelRunning,    int32_t,  RET_int32_t)
+SVC_0_1(svcKernelSuspend,    int32_t,  RET_int32_t)
+SVC_1_1(svcKernelResume,     osStatus, uint32_t, RET_osStatus)
 
 extern void  sysThreadError   (osStatus status);
 osThreadId   svcThreadCreate  (osThreadDef_t *thread_def, void *argument);
@@ -502,6 +504,17 @@ int32_t svcKernelRunning(void) {
   return os_running;
 }
 
+/// Suspend the RTOS Kernel scheduler
+int32_t svcKernelSuspend (void) {
+  return rt_suspend();
+}
+
+/// Resume the RTOS Kernel scheduler
+osStatus svcKernelResume (uint32_t sleep_time) {
+  rt_resume(sleep_time);
+  return osOK;
+}
+
 // Kernel Control Public API
 
 /// Initialize the RTOS Kernel for creating objects
@@ -556,6 +569,18 @@ int32_t osKernelRunning(void) {
   }
 }
 
+/// Suspend the RTOS Kernel scheduler for tickless operation
+uint32_t os_suspend (void) {
+  if (__get_IPSR() != 0) return 0;              // Not allowed in ISR
+  return __svcKernelSuspend();
+}
+
+/// Resume the RTOS Kernel scheduler after tickless operation
+void os_resume (uint32_t sleep_time) {
+  if (__get_IPSR() != 0) return;                // Not allowed in ISR
+  __svcKernelResume(sleep_time);
+}
+
 
 // ==== Thread Management ====
 
@@ -151,6 +151,13 @@ void rt_resume (U32 sleep_time) {
 }
 
 
+/*--------------------------- rt_psh_pending --------------------------------*/
+U32 rt_psh_pending (void) {
+  /* Check for a post service request held back by a locked scheduler */
+  return (os_psh_flag);
+}
+
+
 /*--------------------------- rt_tsk_lock -----------------------------------*/
 
 void rt_tsk_lock (void) {
@@ -39,6 +39,7 @@ extern int os_tick_irqn;
 /* Functions */
 extern U32  rt_suspend    (void);
 extern void rt_resume     (U32 sleep_time);
+extern U32  rt_psh_pending(void);
 extern void rt_tsk_lock   (void);
 extern void rt_tsk_unlock (void);
 extern void rt_psh_req    (void);
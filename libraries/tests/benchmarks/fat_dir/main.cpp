@@ -0,0 +1,195 @@
+#include "mbed.h"
+#include "HeapBlockDevice.h"
+#include "FATDirHandle.h"
+
+/* Lookups in a large directory, with and without the directory cache of
+ * FATFileSystem. The defaults need a PC:
+ *   python workspace_tools/host.py -n BENCHMARK_9
+ * on a target, build with a few hundred files.
+ */
+#ifndef BENCH_DIR_FILES
+#define BENCH_DIR_FILES     5000
+#endif
+#ifndef BENCH_LOOKUPS
+#define BENCH_LOOKUPS       500
+#endif
+#ifndef BENCH_CACHE_ENTRIES
+#define BENCH_CACHE_ENTRIES 8192
+#endif
+#ifndef BENCH_DISK_SECTORS
+#define BENCH_DISK_SECTORS  4096        // 2MB
+#endif
+#ifndef BENCH_CLUSTER
+#define BENCH_CLUSTER       4096
+#endif
+
+// Roughly an SD card on a 25MHz SPI bus; set both to 0 to time the code alone
+#ifndef BENCH_COMMAND_US
+#define BENCH_COMMAND_US    0
+#endif
+#ifndef BENCH_SECTOR_US
+#define BENCH_SECTOR_US     0
+#endif
+
+HeapBlockDevice disk("disk", BENCH_DISK_SECTORS);
+
+static Timer timer;
+static char drive[] = "0:/";
+static char dir_path[] = "0:/logs";
+static int failures = 0;
+
+static void start() {
+    disk.reset_stats();
+    timer.reset();
+    timer.start();
+}
+
+static void report(const char *name, int count) {
+    timer.stop();
+    int us = timer.read_us();
+    const EmulatedBlockDevice::Stats &stats = disk.stats();
+    printf("%-24s %9d us %7d us/op  reads %6u (%7u sectors)  writes %5u\r\n", name, us,
+           count > 0 ? us / count : 0, stats.reads, stats.sectors_read, stats.writes);
+}
+
+static void file_name(char *name, int i) {
+    sprintf(name, "logs/%05d_log_entry.txt", i);
+}
+
+static bool exists(const char *name) {
+    char path[sizeof(drive) + sizeof("logs/") + NAME_MAX];
+    FILINFO info;
+#if _USE_LFN
+    info.lfname = NULL;
+    info.lfsize = 0;
+#endif
+    snprintf(path, sizeof(path), "%s%s", drive, name);
+    return f_stat(path, &info) == FR_OK;
+}
+
+static void lookups(const char *title) {
+    char name[32];
+    char label[32];
+
+    srand(1);
+    sprintf(label, "open, %s", title);
+    start();
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        file_name(name, rand() % BENCH_DIR_FILES);
+        FileHandle *fh = disk.open(name, O_RDONLY);
+        if (fh == NULL) {
+            failures++;
+        } else {
+            fh->close();
+        }
+    }
+    report(label, BENCH_LOOKUPS);
+
+    // the same files again
+    srand(1);
+    sprintf(label, "open again, %s", title);
+    start();
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {
+        file_name(name, rand() % BENCH_DIR_FILES);
+        FileHandle *fh = disk.open(name, O_RDONLY);
+        if (fh == NULL) {
+            failures++;
+        } else {
+            fh->close();
+        }
+    }
+    report(label, BENCH_LOOKUPS);
+
+    sprintf(label, "list + stat, %s", title);
+    start();
+    int entries = 0;
+    DirHandle *dir = disk.opendir("logs");
+    struct dirent *entry;
+    char path[sizeof("logs/") + NAME_MAX];
+    while ((entry = dir->readdir()) != NULL) {
+        snprintf(path, sizeof(path), "logs/%s", entry->d_name);
+        if (!exists(path)) {
+            failures++;
+        }
+        entries++;
+    }
+    dir->closedir();
+    report(label, entries);
+    if (entries != BENCH_DIR_FILES) {
+        failures++;
+    }
+}
+
+int main() {
+    printf("%d files, %d lookups, latency %d us + %d us/sector\r\n",
+           BENCH_DIR_FILES, BENCH_LOOKUPS, BENCH_COMMAND_US, BENCH_SECTOR_US);
+    disk.set_latency(BENCH_COMMAND_US, BENCH_SECTOR_US);
+    drive[0] += disk._fsid;
+    dir_path[0] += disk._fsid;
+
+    // the root directory of FAT12/16 holds 512 entries at most
+    if (f_mkfs(disk._fsid, 1, BENCH_CLUSTER) != FR_OK || f_mkdir(dir_path) != FR_OK) {
+        printf("format failed\r\n");
+        return 1;
+    }
+
+    char name[32];
+    start();
+    for (int i = 0; i < BENCH_DIR_FILES; i++) {
+        file_name(name, i);
+        FileHandle *fh = disk.open(name, O_WRONLY | O_CREAT | O_TRUNC);
+        if (fh == NULL) {
+            printf("cannot create %s\r\n", name);
+            return 1;
+        }
+        fh->close();
+    }
+    report("create", BENCH_DIR_FILES);
+
+    lookups("no cache");
+    if (disk.enable_dir_cache(BENCH_CACHE_ENTRIES) != 0) {
+        printf("cannot allocate the cache\r\n");
+        return 1;
+    }
+    lookups("cache");
+
+    // the status comes with the entry, instead of a lookup of its name
+    start();
+    int entries = 0;
+    FATDirHandle *dir = static_cast<FATDirHandle*>(disk.opendir("logs"));
+    struct dirent entry;
+    FILINFO info;
+    while (dir->readdir(&entry, &info) == 1) {
+        entries++;
+    }
+    dir->closedir();
+    report("list with FILINFO", entries);
+
+    // removed and renamed files must not be found at their old location
+    for (int i = 0; i < BENCH_DIR_FILES; i += 3) {
+        file_name(name, i);
+        disk.remove(name);
+    }
+    char path[40], new_path[40];
+    sprintf(path, "%s/%05d_log_entry.txt", dir_path, 1);
+    strcpy(new_path, "logs/00001_renamed.txt");  // without the drive
+    f_rename(path, new_path);
+    for (int i = 0; i < BENCH_DIR_FILES; i++) {
+        file_name(name, i);
+        if (exists(name) != (i % 3 != 0 && i != 1)) {
+            printf("%s found after its removal, or lost\r\n", name);
+            failures++;
+        }
+    }
+    if (!exists("logs/00001_renamed.txt")) {
+        failures++;
+    }
+    // reuses the entries of the removed files
+    disk.open("logs/00000_log_entry.txt", O_WRONLY | O_CREAT)->close();
+    if (!exists("logs/00000_log_entry.txt") || !exists("logs/00002_log_entry.txt")) {
+        failures++;
+    }
+
+    printf("%d failures\r\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,143 @@
+#include "mbed.h"
+#include "HeapBlockDevice.h"
+#include "ImageFileBlockDevice.h"
+
+/* The defaults fit in the RAM of an LPC1768; on a PC, build with larger
+ * sizes, for instance:
+ *   python workspace_tools/host.py -n BENCHMARK_8 -D BENCH_DISK_SECTORS=262144 -D BENCH_FILE_SIZE=8388608
+ */
+#ifndef BENCH_DISK_SECTORS
+#define BENCH_DISK_SECTORS  1024        // 512kB
+#endif
+#ifndef BENCH_FILE_SIZE
+#define BENCH_FILE_SIZE     (8 * 1024)
+#endif
+#ifndef BENCH_CHUNK
+#define BENCH_CHUNK         1024
+#endif
+#ifndef BENCH_RANDOM_OPS
+#define BENCH_RANDOM_OPS    100
+#endif
+#ifndef BENCH_FILES
+#define BENCH_FILES         32
+#endif
+
+// Roughly an SD card on a 25MHz SPI bus; set both to 0 to time the code alone
+#ifndef BENCH_COMMAND_US
+#define BENCH_COMMAND_US    250
+#endif
+#ifndef BENCH_SECTOR_US
+#define BENCH_SECTOR_US     170
+#endif
+
+// Define BENCH_IMAGE as the path of a disk image to use it instead of RAM
+#ifdef BENCH_IMAGE
+ImageFileBlockDevice disk("disk", BENCH_IMAGE, BENCH_DISK_SECTORS);
+#else
+HeapBlockDevice disk("disk", BENCH_DISK_SECTORS);
+#endif
+
+static char buffer[BENCH_CHUNK];
+static Timer timer;
+
+static void start() {
+    disk.reset_stats();
+    timer.reset();
+    timer.start();
+}
+
+static void report(const char *name, int bytes) {
+    timer.stop();
+    int us = timer.read_us();
+    const EmulatedBlockDevice::Stats &stats = disk.stats();
+    printf("%-20s %9d us", name, us);
+    if (bytes > 0 && us > 0) {
+        printf(" %7d kB/s", (int)((long long)bytes * 1000 / 1024 * 1000 / us));
+    } else {
+        printf("            ");
+    }
+    printf("  reads %5u (%6u sectors)  writes %5u (%6u sectors)\r\n",
+           stats.reads, stats.sectors_read, stats.writes, stats.sectors_written);
+}
+
+int main() {
+    printf("disk %d sectors, file %d bytes in %d byte pieces, latency %d us + %d us/sector\r\n",
+           BENCH_DISK_SECTORS, BENCH_FILE_SIZE, BENCH_CHUNK, BENCH_COMMAND_US, BENCH_SECTOR_US);
+    disk.set_latency(BENCH_COMMAND_US, BENCH_SECTOR_US);
+    
+    start();
+    if (disk.format() != 0) {
+        printf("format failed\r\n");
+        return 1;
+    }
+    report("format", 0);
+    
+    // remount, and time the first access
+    char drive[] = "0:/";
+    drive[0] += disk._fsid;
+    f_mount(disk._fsid, NULL);
+    f_mount(disk._fsid, &disk._fs);
+    FATFS_DIR root;
+    start();
+    f_opendir(&root, drive);
+    report("mount", 0);
+    
+    for (int i = 0; i < BENCH_CHUNK; i++) {
+        buffer[i] = (char)i;
+    }
+    
+    start();
+    FileHandle *fh = disk.open("seq.bin", O_WRONLY | O_CREAT | O_TRUNC);
+    for (int n = 0; n < BENCH_FILE_SIZE; n += BENCH_CHUNK) {
+        fh->write(buffer, BENCH_CHUNK);
+    }
+    fh->close();
+    report("sequential write", BENCH_FILE_SIZE);
+    
+    start();
+    fh = disk.open("seq.bin", O_RDONLY);
+    for (int n = 0; n < BENCH_FILE_SIZE; n += BENCH_CHUNK) {
+        fh->read(buffer, BENCH_CHUNK);
+    }
+    fh->close();
+    report("sequential read", BENCH_FILE_SIZE);
+    
+    srand(1);
+    start();
+    fh = disk.open("seq.bin", O_RDONLY);
+    for (int i = 0; i < BENCH_RANDOM_OPS; i++) {
+        fh->lseek(rand() % (BENCH_FILE_SIZE / 512) * 512, SEEK_SET);
+        fh->read(buffer, 512);
+    }
+    fh->close();
+    report("random read", BENCH_RANDOM_OPS * 512);
+    
+    start();
+    fh = disk.open("seq.bin", O_RDWR);
+    for (int i = 0; i < BENCH_RANDOM_OPS; i++) {
+        fh->lseek(rand() % (BENCH_FILE_SIZE / 512) * 512, SEEK_SET);
+        fh->write(buffer, 512);
+    }
+    fh->close();
+    report("random write", BENCH_RANDOM_OPS * 512);
+    
+    char name[16];
+    start();
+    for (int i = 0; i < BENCH_FILES; i++) {
+        sprintf(name, "file%03d.txt", i);
+        disk.open(name, O_WRONLY | O_CREAT | O_TRUNC)->close();
+    }
+    report("create files", 0);
+    
+    start();
+    int entries = 0;
+    DirHandle *dir = disk.opendir("");
+    while (dir->readdir() != NULL) {
+        entries++;
+    }
+    dir->closedir();
+    report("list directory", 0);
+    printf("%d entries\r\n", entries);
+    
+    return 0;
+}
@@ -0,0 +1,5 @@
+#include "mbed.h"
+
+int main() {
+    mbed_printf("Hello World!");
+}
@@ -0,0 +1,66 @@
+#include "mbed.h"
+
+#define LINES   200
+
+Serial pc(USBTX, USBRX);
+
+int main() {
+    Timer t;
+    int chars;
+
+    // fast enough that formatting, not the line, is the bottleneck
+    pc.baud(921600);
+
+    chars = 0;
+    t.start();
+    for (int i = 0; i < LINES; i++) {
+        chars += pc.printf("%4d: x=%6d y=%6d z=%6d status=%08X\r\n", i, i * 3, -i * 7, i * i, 0xA5A50000 + i);
+    }
+    t.stop();
+    int printf_us = t.read_us();
+    int printf_chars = chars;
+
+    chars = 0;
+    t.reset();
+    t.start();
+    for (int i = 0; i < LINES; i++) {
+        chars += pc.puts("0123456789012345678901234567890123456789012345\r\n") == 0 ? 48 : 0;
+    }
+    t.stop();
+    int puts_us = t.read_us();
+    int puts_chars = chars;
+
+    // formatting alone, without the serial port
+    char buffer[64];
+    t.reset();
+    t.start();
+    for (int i = 0; i < LINES; i++) {
+        snprintf(buffer, sizeof(buffer), "%4d: x=%6d t=%8.3f\r\n", i, i * 3, i * 0.125f);
+    }
+    t.stop();
+    int snprintf_us = t.read_us();
+
+    t.reset();
+    t.start();
+    for (int i = 0; i < LINES; i++) {
+        mbed_snprintf(buffer, sizeof(buffer), "%4d: x=%6d t=%8.3f\r\n", i, i * 3, i * 0.125f);
+    }
+    t.stop();
+    int mbed_snprintf_us = t.read_us();
+
+    static const PrintfFormat format("%4d: x=%6d t=%8.3f\r\n");
+    t.reset();
+    t.start();
+    for (int i = 0; i < LINES; i++) {
+        format.snprintf(buffer, sizeof(buffer), i, i * 3, i * 0.125f);
+    }
+    t.stop();
+    int format_us = t.read_us();
+
+    pc.printf("\r\nSerial::printf: %d chars in %d us, %d chars/s\r\n",
+              printf_chars, printf_us, (int)(printf_chars * 1000000LL / printf_us));
+    pc.printf("Serial::puts:   %d chars in %d us, %d chars/s\r\n",
+              puts_chars, puts_us, (int)(puts_chars * 1000000LL / puts_us));
+    pc.printf("%d lines: snprintf %d us, mbed_snprintf %d us, PrintfFormat %d us\r\n",
+              LINES, snprintf_us, mbed_snprintf_us, format_us);
+}
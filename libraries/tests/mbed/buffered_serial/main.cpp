@@ -0,0 +1,80 @@
+#include "test_env.h"
+#include "BufferedSerial.h"
+
+#if !defined(TARGET_LPC1768)
+#error This test can't run on this target.
+#endif
+
+// p13 (tx) and p14 (rx) must be connected together
+BufferedSerial loop(p13, p14, 1024, 2048);
+
+#define LENGTH  2000
+
+static char tx[LENGTH];
+static char rx[LENGTH];
+
+int main() {
+    bool result = true;
+    Timer t;
+
+    loop.baud(921600);
+    for (int i = 0; i < LENGTH; i++) {
+        tx[i] = i * 13;
+    }
+
+    // write() returns as soon as the data is in the transmit buffer
+    t.start();
+    int written = loop.write(tx, 1000);
+    int queued_us = t.read_us();
+    written += loop.write(tx + 1000, LENGTH - 1000);
+    int blocked_us = t.read_us() - queued_us;
+    printf("1000 bytes queued in %d us, 1000 more in %d us\r\n", queued_us, blocked_us);
+    if (written != LENGTH) {
+        printf("%d of %d bytes written\r\n", written, LENGTH);
+        result = false;
+    }
+
+    loop.set_timeout(100);
+    int n = loop.read(rx, LENGTH);
+    t.stop();
+    printf("%d bytes echoed in %d us, %u overruns\r\n", n, t.read_us(), loop.rx_overruns());
+    if (n != LENGTH || memcmp(tx, rx, LENGTH) != 0 || loop.rx_overruns() != 0) {
+        result = false;
+    }
+
+    // nothing more to read: the timeout expires
+    t.reset();
+    t.start();
+    if (loop.getc() != -1 || t.read_ms() < 100) {
+        printf("getc did not time out\r\n");
+        result = false;
+    }
+
+    // a full receive buffer drops and counts the excess
+    loop.set_timeout(-1);
+    loop.write(tx, LENGTH);
+    loop.write(tx, 100);
+    wait_ms(50);
+    printf("%d bytes buffered, %u overruns\r\n", loop.readable(), loop.rx_overruns());
+    if (loop.readable() != 2048 || loop.rx_overruns() != LENGTH + 100 - 2048) {
+        result = false;
+    }
+
+    // as the console, a line of stdout is one write()
+    char line[201];
+    memset(line, 'x', 198);
+    strcpy(line + 198, "\r\n");
+    loop.set_timeout(100);
+    while (loop.read(rx, sizeof(rx)) > 0);
+    set_console(&loop);
+    printf("%s", line);
+    fflush(stdout);
+    set_console(NULL);
+    n = loop.read(rx, 200);
+    if (n != 200 || memcmp(rx, line, 200) != 0) {
+        printf("console: %d of 200 bytes echoed\r\n", n);
+        result = false;
+    }
+
+    notify_completion(result);
+}
@@ -0,0 +1,81 @@
+#include "test_env.h"
+
+#if !defined(TARGET_LPC1768)
+#error This test can't run on this target.
+#endif
+
+// p26-p21 are P2.0-P2.5: a bus within one port, in port bit order
+#define BUS_MASK    0x3F
+
+#define RUNS        100
+
+BusOut bus(p26, p25, p24, p23, p22, p21);
+// the same pins, left as outputs, to see which edges the first interrupt reports
+InterruptInGroup edges(Port2, BUS_MASK, PIN_OUTPUT);
+
+// p5 is P0.9, p20 is P1.31
+BusOut split(p5, p20);
+
+static volatile int irqs, first_rise, first_fall;
+
+static void on_edges(int rise, int fall) {
+    if (irqs++ == 0) {
+        first_rise = rise;
+        first_fall = fall;
+    }
+}
+
+/* SysTick counts down at the core clock; the mbed library does not use it
+   when the RTOS is not linked. The cycle counts are only reported */
+static uint32_t write_cycles(BusOut &b, int value) {
+    SysTick->LOAD = 0xFFFFFF;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    uint32_t best = 0xFFFFFF;
+    for (int i = 0; i < RUNS; i++) {
+        uint32_t start = SysTick->VAL;
+        b.write(value);
+        uint32_t cycles = (start - SysTick->VAL) & 0xFFFFFF;
+        if (cycles < best) best = cycles;
+    }
+    return best;
+}
+
+/* Drive the bus to 'value' and check that the pins read back and that all
+   their edges are reported by a single interrupt. The interrupt is taken
+   several cycles after the write, so this cannot tell a write of the port
+   in one store from one in two close stores */
+static bool check_edges(int value, int rise, int fall) {
+    irqs = 0;
+    first_rise = first_fall = 0;
+    bus = value;
+    wait_ms(1);
+    if (bus.read() != value) {
+        printf("[0x%02X] read back 0x%02X\r\n", value, bus.read());
+        return false;
+    }
+    if (irqs != 1 || first_rise != rise || first_fall != fall) {
+        printf("[0x%02X] %d interrupts, first: rise 0x%02X fall 0x%02X\r\n",
+               value, irqs, first_rise, first_fall);
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    bool result = true;
+
+    bus = 0;
+    edges.attach(on_edges);
+
+    result = result && check_edges(BUS_MASK, BUS_MASK, 0);
+    result = result && check_edges(0x15, 0, 0x2A);
+    result = result && check_edges(0x2A, 0x2A, 0x15);
+    result = result && check_edges(0, 0, 0x2A);
+
+    printf("Same port bus:  %u cycles per write\r\n", write_cycles(bus, 0x2A));
+    printf("Two port bus:   %u cycles per write\r\n", write_cycles(split, 0x3));
+
+    notify_completion(result);
+}
@@ -0,0 +1,60 @@
+#include "mbed.h"
+#include "SDFileSystem.h"
+#include "test_env.h"
+
+#if defined(TARGET_KL25Z)
+SDFileSystem sd(PTD2, PTD3, PTD1, PTD0, "sd");
+#else
+SDFileSystem sd(p11, p12, p13, p14, "sd");
+#endif
+
+// Small appends to a few files, as a data logger does
+#define FILES   3
+#define RECORDS 200
+
+int main() {
+    char name[16];
+    char line[32];
+    
+    FILE *f[FILES];
+    for (int i = 0; i < FILES; i++) {
+        sprintf(name, "/sd/log%d.txt", i);
+        f[i] = fopen(name, "w");
+        if (f[i] == NULL) {
+            printf("could not open %s\r\n", name);
+            notify_completion(false);
+        }
+        setvbuf(f[i], NULL, _IONBF, 0);
+    }
+    
+    sd._cache.reset_stats();
+    for (int r = 0; r < RECORDS; r++) {
+        for (int i = 0; i < FILES; i++) {
+            fprintf(f[i], "%d:%05d\n", i, r);
+        }
+    }
+    for (int i = 0; i < FILES; i++) {
+        fclose(f[i]);
+    }
+    
+    const FATSectorCache::Stats &stats = sd._cache.stats();
+    printf("hits %u, misses %u, written back %u, bypassed %u\r\n",
+           stats.hits, stats.misses, stats.writebacks, stats.bypassed);
+    
+    // read the records back
+    for (int i = 0; i < FILES; i++) {
+        sprintf(name, "/sd/log%d.txt", i);
+        FILE *in = fopen(name, "r");
+        for (int r = 0; r < RECORDS; r++) {
+            char expected[32];
+            sprintf(expected, "%d:%05d\n", i, r);
+            if (fgets(line, sizeof(line), in) == NULL || strcmp(line, expected) != 0) {
+                printf("%s: bad record %d\r\n", name, r);
+                notify_completion(false);
+            }
+        }
+        fclose(in);
+    }
+    
+    notify_completion(stats.hits > 0);
+}
@@ -0,0 +1,122 @@
+#include "mbed.h"
+#include "FATFileSystem.h"
+#include "FATFileHandle.h"
+#include "test_env.h"
+
+#define FILE_SIZE   (100 * 1024 * 1024)
+#define DISK_SIZE   (110 * 1024 * 1024)
+#define CLUSTER     (32 * 1024)
+#define SEEKS       50
+
+/* A RAM disk which only stores the sectors which are not all zeros: a
+ * file made by seeking past its end only writes its FAT sectors, so a
+ * 100MB volume fits in a few kB */
+#define POOL        32
+
+class SparseRAMDisk : public FATFileSystem {
+public:
+    SparseRAMDisk(const char *name) : FATFileSystem(name) {
+        memset(_sector, 0xFF, sizeof(_sector));
+    }
+
+    virtual int disk_read(uint8_t *buffer, uint64_t sector) {
+        int i = find(sector);
+        if (i < 0) {
+            memset(buffer, 0, 512);
+        } else {
+            memcpy(buffer, _data[i], 512);
+        }
+        return 0;
+    }
+
+    virtual int disk_write(const uint8_t *buffer, uint64_t sector) {
+        bool zero = true;
+        for (int j = 0; j < 512 && zero; j++) {
+            zero = (buffer[j] == 0);
+        }
+        int i = find(sector);
+        if (zero) {
+            if (i >= 0) {
+                _sector[i] = 0xFFFFFFFF;
+            }
+            return 0;
+        }
+        if (i < 0 && (i = find(0xFFFFFFFF)) < 0) {
+            printf("RAM disk full\r\n");
+            return 1;
+        }
+        _sector[i] = sector;
+        memcpy(_data[i], buffer, 512);
+        return 0;
+    }
+
+    virtual uint64_t disk_sectors() {
+        return DISK_SIZE / 512;
+    }
+
+private:
+    int find(uint32_t sector) {
+        for (int i = 0; i < POOL; i++) {
+            if (_sector[i] == sector) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    uint32_t _sector[POOL];
+    uint8_t _data[POOL][512];
+};
+
+SparseRAMDisk ram("ram");
+
+// average time of a seek to a random offset and a small read, in us
+static int seek_time(FileHandle *fh) {
+    char buffer[16];
+    Timer timer;
+    srand(1);
+    timer.start();
+    for (int i = 0; i < SEEKS; i++) {
+        off_t offset = ((rand() << 8) ^ rand()) % (FILE_SIZE - sizeof(buffer));
+        if (fh->lseek(offset, SEEK_SET) != offset || fh->read(buffer, sizeof(buffer)) != sizeof(buffer)) {
+            printf("seek to %ld failed\r\n", offset);
+            notify_completion(false);
+        }
+    }
+    timer.stop();
+    return timer.read_us() / SEEKS;
+}
+
+int main() {
+    if (f_mkfs(ram._fsid, 1, CLUSTER) != FR_OK) {
+        printf("format failed\r\n");
+        notify_completion(false);
+    }
+    
+    // make the file by seeking to its end, which allocates the clusters
+    FileHandle *fh = ram.open("big.bin", O_WRONLY | O_CREAT | O_TRUNC);
+    if (fh == NULL || fh->lseek(FILE_SIZE - 1, SEEK_SET) != FILE_SIZE - 1 || fh->write("", 1) != 1) {
+        printf("could not make a %d byte file\r\n", FILE_SIZE);
+        notify_completion(false);
+    }
+    fh->close();
+    
+    FATFileHandle *file = static_cast<FATFileHandle*>(ram.open("big.bin", O_RDONLY));
+    int chain = seek_time(file);
+    printf("following the FAT chain: %d us per seek\r\n", chain);
+    
+    int result = file->enable_fast_seek();
+    if (result != 0) {
+        printf("enable_fast_seek() failed: %d\r\n", result);
+        notify_completion(false);
+    }
+    int map = seek_time(file);
+    printf("with the cluster map: %d us per seek\r\n", map);
+    
+    // a map which is too small reports the size needed
+    result = file->enable_fast_seek(2);
+    printf("a 2 entry map needs %d entries\r\n", result);
+    
+    file->close();
+    notify_completion(map < chain && result > 2);
+}
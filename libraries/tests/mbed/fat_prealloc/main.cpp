@@ -0,0 +1,79 @@
+#include "mbed.h"
+#include "SDFileSystem.h"
+#include "FATFileHandle.h"
+#include "test_env.h"
+
+#if defined(TARGET_KL25Z)
+SDFileSystem sd(PTD2, PTD3, PTD1, PTD0, "sd");
+#else
+SDFileSystem sd(p11, p12, p13, p14, "sd");
+#endif
+
+// Fixed size records, appended a sector at a time, as a data logger does
+#define RECORD      512
+#define RECORDS     512
+#define SYNC_EVERY  64
+
+static uint8_t record[RECORD];
+
+static void fill(int r) {
+    for (int i = 0; i < RECORD; i++) {
+        record[i] = (uint8_t)(r + i);
+    }
+}
+
+// worst time of a record append, in us
+static int append(FileHandle *fh) {
+    Timer timer;
+    int worst = 0;
+    for (int r = 0; r < RECORDS; r++) {
+        fill(r);
+        timer.reset();
+        timer.start();
+        if (fh->write(record, RECORD) != RECORD) {
+            printf("write failed at record %d\r\n", r);
+            notify_completion(false);
+        }
+        timer.stop();
+        if (timer.read_us() > worst) {
+            worst = timer.read_us();
+        }
+        if (r % SYNC_EVERY == SYNC_EVERY - 1) {
+            fh->fsync();
+        }
+    }
+    fh->close();
+    return worst;
+}
+
+static bool check(const char *name) {
+    FileHandle *fh = sd.open(name, O_RDONLY);
+    if (fh == NULL || fh->flen() != RECORD * RECORDS) {
+        return false;
+    }
+    static uint8_t data_read[RECORD];
+    for (int r = 0; r < RECORDS; r++) {
+        fill(r);
+        if (fh->read(data_read, RECORD) != RECORD || memcmp(data_read, record, RECORD) != 0) {
+            fh->close();
+            return false;
+        }
+    }
+    fh->close();
+    return true;
+}
+
+int main() {
+    int plain = append(sd.open("plain.bin", O_WRONLY | O_CREAT | O_TRUNC));
+    printf("allocating as it grows: worst append %d us\r\n", plain);
+    
+    FileHandle *fh = sd.open_prealloc("prealloc.bin", RECORD * RECORDS);
+    if (fh == NULL) {
+        printf("open_prealloc() failed\r\n");
+        notify_completion(false);
+    }
+    int reserved = append(fh);
+    printf("reserved: worst append %d us\r\n", reserved);
+    
+    notify_completion(check("plain.bin") && check("prealloc.bin"));
+}
@@ -0,0 +1,117 @@
+#include "mbed.h"
+#include "test_env.h"
+
+#define FILE_SYSTEMS    20
+#define ROUNDS          500
+#define FILES           4
+
+// A file system which only counts its open files
+class CountingFile : public FileHandle {
+public:
+    CountingFile(int *count) : _count(count) {
+        (*_count)++;
+    }
+    virtual ssize_t write(const void *buffer, size_t length) { return length; }
+    virtual ssize_t read(void *buffer, size_t length) { return 0; }
+    virtual int close() {
+        (*_count)--;
+        delete this;
+        return 0;
+    }
+    virtual int isatty() { return 0; }
+    virtual off_t lseek(off_t offset, int whence) { return 0; }
+    virtual int fsync() { return 0; }
+
+private:
+    int *_count;
+};
+
+class CountingFileSystem : public FileSystemLike {
+public:
+    CountingFileSystem(const char *name) : FileSystemLike(name), open_files(0) {}
+    virtual FileHandle *open(const char *filename, int flags) {
+        return new CountingFile(&open_files);
+    }
+    int open_files;
+};
+
+static char names[FILE_SYSTEMS][8];
+static CountingFileSystem *file_systems[FILE_SYSTEMS];
+
+// Open files until it fails, then close them; returns how many were open
+static int open_all() {
+    static FILE *files[256];
+    int n = 0;
+    while (n < 256) {
+        files[n] = fopen("/fs0/file", "w");
+        if (files[n] == NULL)
+            break;
+        n++;
+    }
+    for (int i = 0; i < n; i++) {
+        fclose(files[i]);
+    }
+    return n;
+}
+
+int main() {
+    bool result = true;
+
+    for (int i = 0; i < FILE_SYSTEMS; i++) {
+        sprintf(names[i], "fs%d", i);
+        file_systems[i] = new CountingFileSystem(names[i]);
+    }
+
+    int capacity = open_all();
+    printf("%d files can be open at once\r\n", capacity);
+    if (capacity == 0)
+        result = false;
+
+    // open and close files on all the file systems
+    Timer t;
+    t.start();
+    char path[32];
+    FILE *files[FILES];
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < FILES; i++) {
+            sprintf(path, "/fs%d/log%d.txt", (round + i) % FILE_SYSTEMS, i);
+            files[i] = fopen(path, "w");
+            if (files[i] == NULL) {
+                printf("cannot open %s\r\n", path);
+                result = false;
+            }
+        }
+        for (int i = 0; i < FILES; i++) {
+            if (files[i] != NULL)
+                fclose(files[i]);
+        }
+    }
+    t.stop();
+    printf("%d opens and closes in %d us\r\n", ROUNDS * FILES, t.read_us());
+
+    // failed opens must not use up slots
+    for (int i = 0; i < 100; i++) {
+        if (fopen("/nothing/file", "w") != NULL)
+            result = false;
+    }
+
+    for (int i = 0; i < FILE_SYSTEMS; i++) {
+        if (file_systems[i]->open_files != 0) {
+            printf("%s has %d files open\r\n", names[i], file_systems[i]->open_files);
+            result = false;
+        }
+    }
+    if (open_all() != capacity) {
+        printf("file handles were lost\r\n");
+        result = false;
+    }
+
+    // a removed file system is not found any more
+    delete file_systems[5];
+    if (fopen("/fs5/file", "w") != NULL)
+        result = false;
+    if (open_all() != capacity)
+        result = false;
+
+    notify_completion(result);
+}
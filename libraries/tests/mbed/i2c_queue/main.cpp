@@ -0,0 +1,89 @@
+#include "test_env.h"
+
+#if !DEVICE_I2C_ASYNCH
+#error This test can't run on this target.
+#endif
+
+// a TMP102 at 0x90; nothing answers at 0x20
+#define TMP102_ADDRESS  0x90
+#define NO_ADDRESS      0x20
+
+#define N_TRANSACTIONS  12
+
+I2C i2c(p28, p27);
+
+static const char reg = 0x00;       // temperature register
+static char data[N_TRANSACTIONS][2];
+static I2CTransaction transactions[N_TRANSACTIONS];
+
+static volatile int completed;
+static int order[N_TRANSACTIONS];
+static int results[N_TRANSACTIONS];
+
+class Recorder {
+public:
+    Recorder(int index) : index(index) {}
+    void done(int result) {
+        order[completed] = index;
+        results[index] = result;
+        completed++;
+    }
+    int index;
+};
+
+int main() {
+    bool result = true;
+    Recorder *recorders[N_TRANSACTIONS];
+
+    // alternate reads of the sensor (register write, repeated start, read)
+    // with writes to a missing slave
+    for (int i = 0; i < N_TRANSACTIONS; i++) {
+        recorders[i] = new Recorder(i);
+        if (i % 2 == 0) {
+            transactions[i] = I2CTransaction(TMP102_ADDRESS, &reg, 1, data[i], 2);
+        } else {
+            transactions[i] = I2CTransaction(NO_ADDRESS, &reg, 1);
+        }
+    }
+
+    for (int i = 0; i < N_TRANSACTIONS; i++) {
+        if (i2c.transfer(&transactions[i], Callback<void(int)>(recorders[i], &Recorder::done)) != 0) {
+            printf("transaction %d not queued\r\n", i);
+            result = false;
+        }
+    }
+    // queuing a pending transaction fails
+    if (i2c.transfer(&transactions[N_TRANSACTIONS - 1]) != -1) {
+        printf("pending transaction queued twice\r\n");
+        result = false;
+    }
+
+    Timer t;
+    t.start();
+    while (i2c.busy() && t.read_ms() < 1000);
+    if (completed != N_TRANSACTIONS) {
+        printf("%d of %d transactions completed\r\n", completed, N_TRANSACTIONS);
+        notify_completion(false);
+    }
+
+    for (int i = 0; i < N_TRANSACTIONS; i++) {
+        int expected = (i % 2 == 0) ? 0 : I2C_ERROR_NO_SLAVE;
+        if (order[i] != i) {
+            printf("completion %d was transaction %d\r\n", i, order[i]);
+            result = false;
+        }
+        if (results[i] != expected || transactions[i].result() != expected) {
+            printf("transaction %d: result %d, expected %d\r\n", i, results[i], expected);
+            result = false;
+        }
+        if (i % 2 == 0) {
+            float temperature = ((data[i][0] << 4) | (data[i][1] >> 4)) * 0.0625f;
+            printf("transaction %d: %.2f C\r\n", i, temperature);
+            if (temperature <= 15.0f || temperature >= 30.0f) {
+                result = false;
+            }
+        }
+    }
+
+    notify_completion(result);
+}
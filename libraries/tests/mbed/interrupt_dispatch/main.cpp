@@ -0,0 +1,73 @@
+#include "mbed.h"
+#include "InterruptManager.h"
+#include "cmsis.h"
+#include "us_ticker_api.h"
+
+#if defined(TARGET_LPC1768) || defined(TARGET_LPC4088)
+#define TIMER_IRQ       TIMER3_IRQn
+#elif defined(TARGET_LPC11U24) || defined(TARGET_LPC1114)
+#define TIMER_IRQ       TIMER_32_1_IRQn
+#elif defined(TARGET_KL25Z)
+#define TIMER_IRQ       LPTimer_IRQn
+#elif defined(TARGET_LPC2368)
+#define TIMER_IRQ       TIMER3_IRQn
+#else
+#error This test can't run on this target.
+#endif
+
+#define RUNS    1000
+
+/* SysTick is available on every Cortex-M core and counts down at the core
+   clock; the mbed library does not use it when the RTOS is not linked */
+static volatile uint32_t entry;
+
+static void start_counter(void) {
+    SysTick->LOAD = 0xFFFFFF;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+static void first_handler(void) {
+    entry = SysTick->VAL;
+}
+
+static void other_handler(void) {
+}
+
+/* Software-trigger the interrupt and return the cycles until the first
+   handler of the chain starts */
+static uint32_t measure(IRQn_Type irq) {
+    uint32_t best = 0xFFFFFF, total = 0;
+    for (int i = 0; i < RUNS; i++) {
+        __disable_irq();
+        NVIC_SetPendingIRQ(irq);
+        uint32_t start = SysTick->VAL;
+        __enable_irq();
+        __NOP();
+        uint32_t cycles = (start - entry) & 0xFFFFFF;
+        total += cycles;
+        if (cycles < best) best = cycles;
+    }
+    printf("    best %u cycles, average %u cycles\r\n", best, total / RUNS);
+    return best;
+}
+
+int main() {
+    // the timer vector gets chained after our handlers, make sure it is set
+    us_ticker_init();
+    start_counter();
+    
+    printf("Direct vector:\r\n");
+    uint32_t vector = NVIC_GetVector(TIMER_IRQ);
+    NVIC_SetVector(TIMER_IRQ, (uint32_t)first_handler);
+    NVIC_EnableIRQ(TIMER_IRQ);
+    measure(TIMER_IRQ);
+    NVIC_SetVector(TIMER_IRQ, vector);
+    
+    printf("InterruptManager (%s dispatch):\r\n", INTERRUPT_DIRECT_DISPATCH ? "direct" : "IPSR");
+    InterruptManager::get()->add_handler_front(first_handler, TIMER_IRQ);
+    InterruptManager::get()->add_handler(other_handler, TIMER_IRQ);
+    measure(TIMER_IRQ);
+    
+    printf("Done\r\n");
+}
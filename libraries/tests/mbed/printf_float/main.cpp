@@ -0,0 +1,56 @@
+#include "mbed.h"
+#include "test_env.h"
+
+/* mbed_printf floating point conversions, against the output of the C
+   library of the PC: rounding at the boundaries, half to even, and digits
+   beyond the 9th */
+struct Case {
+    const char *format;
+    double value;
+    const char *expected;
+};
+
+static const Case cases[] = {
+    {"%g", 999999.5, "1e+06"},
+    {"%g", 999999.4, "999999"},
+    {"%.7g", 0.0001313365, "0.0001313365"},
+    {"%.17g", 0.1, "0.10000000000000001"},
+    {"%.3g", 0.00099996, "0.001"},
+    {"%.10g", 1234567.891, "1234567.891"},
+    {"%.0f", 2.5, "2"},
+    {"%.0f", 3.5, "4"},
+    {"%.0f", 0.5, "0"},
+    {"%.2f", 2.675, "2.67"},
+    {"%.1f", 0.25, "0.2"},
+    {"%f", 1e19, "10000000000000000000.000000"},
+    {"%f", 1e22, "10000000000000000000000.000000"},
+    {"%.20f", 0.1, "0.10000000000000000555"},
+    {"%.40f", 5e-324, "0.0000000000000000000000000000000000000000"},
+    {"%e", 0.0, "0.000000e+00"},
+    {"%.3e", 9.9996, "1.000e+01"},
+    {"%.16e", 0.3, "2.9999999999999999e-01"},
+    {"%e", 1.7976931348623157e308, "1.797693e+308"},
+    {"%.2e", 5e-324, "4.94e-324"},
+    {"%g", 1e-5, "1e-05"},
+    {"%g", 0.0001, "0.0001"},
+    {"%g", 100000.0, "100000"},
+    {"%#.3g", 1.0, "1.00"},
+    {"%G", 1e-10, "1E-10"},
+    {"%+.3f", -0.0005, "-0.001"},
+};
+
+int main() {
+    bool result = true;
+    char buffer[64];
+
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const Case &c = cases[i];
+        mbed_snprintf(buffer, sizeof(buffer), c.format, c.value);
+        if (strcmp(buffer, c.expected) != 0) {
+            printf("%s: got \"%s\", expected \"%s\"\r\n", c.format, buffer, c.expected);
+            result = false;
+        }
+    }
+
+    notify_completion(result);
+}
@@ -0,0 +1,67 @@
+#include "mbed.h"
+#include "SDFileSystem.h"
+#include "test_env.h"
+
+#if defined(TARGET_KL25Z)
+SDFileSystem sd(PTD2, PTD3, PTD1, PTD0, "sd");
+#else
+SDFileSystem sd(p11, p12, p13, p14, "sd");
+#endif
+
+// Whole sector writes of several sectors go to the disk in one command
+#define CHUNK   (8 * 512)
+#define CHUNKS  64
+
+static uint8_t buffer[CHUNK];
+
+static void fill(int chunk) {
+    for (int i = 0; i < CHUNK; i++) {
+        buffer[i] = (uint8_t)(chunk * 31 + i);
+    }
+}
+
+int main() {
+    Timer timer;
+    
+    FILE *f = fopen("/sd/seq.bin", "w");
+    if (f == NULL) {
+        printf("could not open /sd/seq.bin\r\n");
+        notify_completion(false);
+    }
+    setvbuf(f, NULL, _IONBF, 0);
+    
+    timer.start();
+    for (int c = 0; c < CHUNKS; c++) {
+        fill(c);
+        if (fwrite(buffer, 1, CHUNK, f) != CHUNK) {
+            printf("write failed at chunk %d\r\n", c);
+            notify_completion(false);
+        }
+    }
+    fclose(f);
+    timer.stop();
+    printf("write: %d bytes in %d ms\r\n", CHUNK * CHUNKS, timer.read_ms());
+    
+    f = fopen("/sd/seq.bin", "r");
+    setvbuf(f, NULL, _IONBF, 0);
+    
+    static uint8_t data_read[CHUNK];
+    timer.reset();
+    timer.start();
+    for (int c = 0; c < CHUNKS; c++) {
+        if (fread(data_read, 1, CHUNK, f) != CHUNK) {
+            printf("read failed at chunk %d\r\n", c);
+            notify_completion(false);
+        }
+        fill(c);
+        if (memcmp(data_read, buffer, CHUNK) != 0) {
+            printf("data mismatch in chunk %d\r\n", c);
+            notify_completion(false);
+        }
+    }
+    timer.stop();
+    fclose(f);
+    printf("read: %d bytes in %d ms\r\n", CHUNK * CHUNKS, timer.read_ms());
+    
+    notify_completion(true);
+}
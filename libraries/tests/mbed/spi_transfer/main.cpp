@@ -0,0 +1,78 @@
+#include "mbed.h"
+#include "test_env.h"
+
+#if !DEVICE_SPI_BLOCK
+#error This test can't run on this target.
+#endif
+
+// p5 (mosi) and p6 (miso) must be connected together
+SPI spi(p5, p6, p7); // mosi, miso, sclk
+
+#define LENGTH  5000
+
+static uint8_t tx[LENGTH];
+static uint8_t rx[LENGTH];
+static volatile bool done;
+
+static void on_done(void) {
+    done = true;
+}
+
+static bool check(const char *name, int us) {
+    for (int i = 0; i < LENGTH; i++) {
+        if (rx[i] != tx[i]) {
+            printf("%s: frame %d sent 0x%02X received 0x%02X\r\n", name, i, tx[i], rx[i]);
+            return false;
+        }
+    }
+    printf("%s: %d bytes in %d us\r\n", name, LENGTH, us);
+    return true;
+}
+
+int main() {
+    bool result = true;
+    Timer t;
+
+    spi.frequency(10000000);
+    for (int i = 0; i < LENGTH; i++) {
+        tx[i] = i * 7;
+    }
+
+    memset(rx, 0, sizeof(rx));
+    t.start();
+    for (int i = 0; i < LENGTH; i++) {
+        rx[i] = spi.write(tx[i]);
+    }
+    t.stop();
+    result = check("write", t.read_us()) && result;
+
+    memset(rx, 0, sizeof(rx));
+    t.reset();
+    t.start();
+    spi.transfer(tx, rx, LENGTH);
+    t.stop();
+    result = check("transfer", t.read_us()) && result;
+
+    // the DMA path splits transfers of more than 4095 frames
+    memset(rx, 0, sizeof(rx));
+    done = false;
+    t.reset();
+    t.start();
+    spi.transfer(tx, rx, LENGTH, on_done);
+    while (!done);
+    t.stop();
+    result = check("transfer (callback)", t.read_us()) && result;
+
+    // with no transmit buffer all ones are sent
+    memset(rx, 0, sizeof(rx));
+    spi.transfer(NULL, rx, 16);
+    for (int i = 0; i < 16; i++) {
+        if (rx[i] != 0xFF) {
+            printf("fill: frame %d received 0x%02X\r\n", i, rx[i]);
+            result = false;
+            break;
+        }
+    }
+
+    notify_completion(result);
+}
@@ -0,0 +1,71 @@
+#include "mbed.h"
+#include "us_ticker_api.h"
+
+#define EVENTS      200
+#define OPERATIONS  10000
+
+static ticker_event_t events[EVENTS];
+static bool pending[EVENTS];
+
+static void event_handler(uint32_t id) {
+    pending[id] = false;
+}
+
+int main() {
+    us_ticker_set_handler(event_handler);
+    for (int i = 0; i < EVENTS; i++) {
+        us_ticker_init_event(&events[i]);
+    }
+    
+    uint32_t worst_insert = 0, worst_remove = 0;
+    uint32_t total_insert = 0, total_remove = 0;
+    int inserts = 0, removes = 0;
+    
+    srand(0);
+    for (int n = 0; n < OPERATIONS; n++) {
+        int i = rand() % EVENTS;
+        if (pending[i]) {
+            uint32_t start = us_ticker_read();
+            us_ticker_remove_event(&events[i]);
+            uint32_t t = us_ticker_read() - start;
+            pending[i] = false;
+            total_remove += t;
+            removes++;
+            if (t > worst_remove) worst_remove = t;
+        } else {
+            // far enough in the future that nothing fires during the run
+            uint32_t timestamp = us_ticker_read() + 10000000 + (rand() % 1000000);
+            pending[i] = true;
+            uint32_t start = us_ticker_read();
+            us_ticker_insert_event(&events[i], timestamp, i);
+            uint32_t t = us_ticker_read() - start;
+            total_insert += t;
+            inserts++;
+            if (t > worst_insert) worst_insert = t;
+        }
+    }
+    
+    for (int i = 0; i < EVENTS; i++) {
+        us_ticker_remove_event(&events[i]);
+    }
+    
+    // The worst case of the heap: after a burst of inserts, every event is a
+    // child of the head, and the first pop pairs them all
+    uint32_t base = us_ticker_read() + 10000000;
+    for (int i = 0; i < EVENTS; i++) {
+        us_ticker_insert_event(&events[i], base + i * 1000, i);
+    }
+    uint32_t start = us_ticker_read();
+    us_ticker_remove_event(&events[0]);
+    uint32_t first_pop = us_ticker_read() - start;
+    start = us_ticker_read();
+    us_ticker_remove_event(&events[1]);
+    uint32_t second_pop = us_ticker_read() - start;
+    for (int i = 0; i < EVENTS; i++) {
+        us_ticker_remove_event(&events[i]);
+    }
+    
+    printf("%d inserts: worst %u us, average %.2f us\r\n", inserts, worst_insert, (float)total_insert / inserts);
+    printf("%d removes: worst %u us, average %.2f us\r\n", removes, worst_remove, (float)total_remove / removes);
+    printf("first pop after %d inserts: %u us, then %u us\r\n", EVENTS, first_pop, second_pop);
+}
@@ -0,0 +1,86 @@
+#include "mbed.h"
+#include "mbed_trace.h"
+#include "test_env.h"
+
+#define EVENTS  10000
+
+static const char event_format[] = "event %u from %d";
+static const char isr_format[] = "tick %u";
+
+static volatile uint32_t ticks;
+
+static void tick() {
+    mbed_trace1(isr_format, ticks++);
+}
+
+int main() {
+    bool result = true;
+    uint32_t buffer[64];
+
+    // cost of a record, with the ring drained often enough not to lose any
+    Timer t;
+    int recorded = 0;
+    uint32_t total_us = 0;
+    while (recorded < EVENTS) {
+        t.reset();
+        t.start();
+        for (int i = 0; i < 100; i++, recorded++) {
+            mbed_trace2(event_format, recorded, -1);
+        }
+        t.stop();
+        total_us += t.read_us();
+
+        uint32_t expected = recorded - 100;
+        int n;
+        while ((n = mbed_trace_read(buffer, 64)) > 0) {
+            for (int i = 0; i < n; i += 4) {
+                if (buffer[i + 1] != (uint32_t)event_format || buffer[i + 2] != expected
+                    || buffer[i + 3] != (uint32_t)-1) {
+                    printf("record %u is wrong\r\n", expected);
+                    result = false;
+                }
+                expected++;
+            }
+        }
+        if (expected != (uint32_t)recorded) {
+            printf("%u records read, %d written\r\n", expected, recorded);
+            result = false;
+        }
+    }
+    printf("%d records in %u us: %d records/s\r\n", EVENTS, total_us,
+           (int)(EVENTS * 1000000LL / total_us));
+
+    // overflow: the records that do not fit are counted
+    for (int i = 0; i < MBED_TRACE_BUFFER; i++) {
+        mbed_trace0(event_format);
+    }
+    int n = mbed_trace_read(buffer, 64);
+    if (n < 3 || buffer[1] != 0 || buffer[2] != MBED_TRACE_BUFFER / 2) {
+        printf("lost records not reported\r\n");
+        result = false;
+    }
+    while (mbed_trace_read(buffer, 64) > 0);
+
+    // records from an interrupt, interleaved with the main loop
+    Ticker ticker;
+    ticker.attach_us(&tick, 50);
+    uint32_t isr_records = 0;
+    for (int i = 0; i < 1000; i++) {
+        mbed_trace1(event_format, i);
+        while ((n = mbed_trace_read(buffer, 64)) > 0) {
+            for (int j = 0; j < n; ) {
+                if (buffer[j + 1] == (uint32_t)isr_format) {
+                    if (buffer[j + 2] != isr_records++)
+                        result = false;
+                }
+                j += 2 + ((buffer[j] >> MBED_TRACE_ARGS_SHIFT) & 0xF);
+            }
+        }
+    }
+    ticker.detach();
+    printf("%u records from the ticker\r\n", isr_records);
+    if (isr_records == 0)
+        result = false;
+
+    notify_completion(result);
+}
@@ -0,0 +1,110 @@
+#include "mbed.h"
+#include "SDFileSystem.h"
+#include "USBHostMSD.h"
+#include "test_env.h"
+#include "rtos.h"
+
+#define FILE_SIZE   (256 * 1024)
+#define CHUNK       4096
+
+SDFileSystem sd(p11, p12, p13, p14, "sd");
+USBHostMSD usb("usb");
+
+struct Copy {
+    const char *from;
+    const char *to;
+    char *buffer;
+    bool ok;
+};
+
+// One buffer per thread, off their stacks
+static char buffers[2][CHUNK];
+
+static bool copy(const char *from, const char *to, char *buffer) {
+    FILE *in = fopen(from, "r");
+    FILE *out = fopen(to, "w");
+    bool ok = (in != NULL) && (out != NULL);
+    size_t n;
+    while (ok && (n = fread(buffer, 1, CHUNK, in)) > 0) {
+        ok = (fwrite(buffer, 1, n, out) == n);
+    }
+    if (in != NULL) fclose(in);
+    if (out != NULL) fclose(out);
+    return ok;
+}
+
+static void copier(void const *argument) {
+    Copy *c = (Copy *)argument;
+    c->ok = copy(c->from, c->to, c->buffer);
+}
+
+static bool fill(const char *path, int seed) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL)
+        return false;
+    for (int n = 0; n < FILE_SIZE; n += CHUNK) {
+        for (int i = 0; i < CHUNK; i++)
+            buffers[0][i] = (char)(seed + n / CHUNK + i);
+        fwrite(buffers[0], 1, CHUNK, f);
+    }
+    fclose(f);
+    return true;
+}
+
+static bool same(const char *a, const char *b) {
+    FILE *fa = fopen(a, "r");
+    FILE *fb = fopen(b, "r");
+    bool ok = (fa != NULL) && (fb != NULL);
+    size_t n;
+    while (ok && (n = fread(buffers[0], 1, CHUNK, fa)) > 0) {
+        ok = (fread(buffers[1], 1, CHUNK, fb) == n) && (memcmp(buffers[0], buffers[1], n) == 0);
+    }
+    if (fa != NULL) fclose(fa);
+    if (fb != NULL) fclose(fb);
+    return ok;
+}
+
+static int kbps(int ms) {
+    return ms > 0 ? 2 * FILE_SIZE / ms * 1000 / 1024 : 0;
+}
+
+int main() {
+    for (int i = 0; !usb.connect(); i++) {
+        if (i == 20) {
+            printf("no USB stick\r\n");
+            notify_completion(false);
+        }
+        Thread::wait(500);
+    }
+
+    if (!fill("/sd/src.bin", 1) || !fill("/usb/src.bin", 2)) {
+        printf("cannot write the source files\r\n");
+        notify_completion(false);
+    }
+
+    // one copy after the other
+    Timer timer;
+    timer.start();
+    bool ok = copy("/sd/src.bin", "/usb/seq.bin", buffers[0])
+           && copy("/usb/src.bin", "/sd/seq.bin", buffers[1]);
+    int sequential = timer.read_ms();
+
+    // both at once, from two threads: the volumes are locked separately
+    Copy to_usb = {"/sd/src.bin", "/usb/par.bin", buffers[0], false};
+    Copy to_sd = {"/usb/src.bin", "/sd/par.bin", buffers[1], false};
+    timer.reset();
+    Thread t1(copier, &to_usb, osPriorityNormal, DEFAULT_STACK_SIZE * 2);
+    Thread t2(copier, &to_sd, osPriorityNormal, DEFAULT_STACK_SIZE * 2);
+    while (t1.get_state() != Thread::Inactive || t2.get_state() != Thread::Inactive) {
+        Thread::wait(1);
+    }
+    int parallel = timer.read_ms();
+
+    printf("sequential %d ms (%d kB/s), parallel %d ms (%d kB/s)\r\n",
+           sequential, kbps(sequential), parallel, kbps(parallel));
+
+    ok = ok && to_usb.ok && to_sd.ok
+         && same("/sd/src.bin", "/usb/seq.bin") && same("/usb/src.bin", "/sd/seq.bin")
+         && same("/sd/src.bin", "/usb/par.bin") && same("/usb/src.bin", "/sd/par.bin");
+    notify_completion(ok && parallel < sequential);
+}
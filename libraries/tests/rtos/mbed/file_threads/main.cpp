@@ -0,0 +1,62 @@
+#include "mbed.h"
+#include "SDFileSystem.h"
+#include "test_env.h"
+#include "rtos.h"
+
+#define LINES   50
+
+Serial pc(USBTX, USBRX);
+
+#if defined(TARGET_KL25Z)
+SDFileSystem sd(PTD2, PTD3, PTD1, PTD0, "sd");
+#else
+SDFileSystem sd(p11, p12, p13, p14, "sd");
+#endif
+
+static volatile bool failed = false;
+
+// Writes its own file while the other thread writes another one on the same
+// volume, and both print to the same serial port
+void writer(void const *argument) {
+    int id = (int)argument;
+    char path[16];
+    sprintf(path, "/sd/t%d.txt", id);
+
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        failed = true;
+        return;
+    }
+    for (int i = 0; i < LINES; i++) {
+        fprintf(f, "thread %d line %d\n", id, i);
+        pc.printf("thread %d line %d\r\n", id, i);
+        Thread::yield();
+    }
+    fclose(f);
+}
+
+static bool check(int id) {
+    char path[16], line[32], expected[32];
+    sprintf(path, "/sd/t%d.txt", id);
+    FILE *f = fopen(path, "r");
+    if (f == NULL)
+        return false;
+    bool ok = true;
+    for (int i = 0; i < LINES && ok; i++) {
+        sprintf(expected, "thread %d line %d\n", id, i);
+        ok = (fgets(line, sizeof(line), f) != NULL) && (strcmp(line, expected) == 0);
+    }
+    fclose(f);
+    return ok;
+}
+
+int main() {
+    Thread t1(writer, (void *)1, osPriorityNormal, DEFAULT_STACK_SIZE * 2);
+    Thread t2(writer, (void *)2, osPriorityNormal, DEFAULT_STACK_SIZE * 2);
+
+    while (t1.get_state() != Thread::Inactive || t2.get_state() != Thread::Inactive) {
+        Thread::wait(10);
+    }
+
+    notify_completion(!failed && check(1) && check(2));
+}
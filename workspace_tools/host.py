@@ -0,0 +1,106 @@
+"""
+mbed SDK
+Copyright (c) 2011-2013 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Build a test program with the compiler of the PC, and run it
+
+Only the parts of the mbed library which do not need the hardware are
+built: the file system classes, Timer, wait() and mbed_printf, with the
+headers of workspace_tools/host standing for the target ones. This is enough
+to run the FAT file system on the emulated block devices of
+libraries/fs/emulated, and the tests which need no peripherals.
+"""
+import sys
+from os import walk
+from os.path import join, abspath, dirname, splitext, isdir
+from optparse import OptionParser
+
+# Be sure that the tools directory is in the search path
+ROOT = abspath(join(dirname(__file__), ".."))
+sys.path.append(ROOT)
+
+from workspace_tools.tests import TEST_MAP, TEST_MBED_LIB
+from workspace_tools.paths import BUILD_DIR, LIB_DIR, MBED_API, MBED_HAL, MBED_COMMON
+from workspace_tools.utils import cmd, mkdir, args_error
+
+HOST_DIR = join(ROOT, "workspace_tools", "host")
+
+# The sources of the mbed library which build on a PC
+MBED_SOURCES = [join(MBED_COMMON, f) for f in [
+    "FileBase.cpp", "FileSystemLike.cpp", "PlatformMutex.cpp",
+    "Timer.cpp", "wait_api.c", "mbed_printf.cpp",
+]] + [join(HOST_DIR, "host.cpp")]
+
+
+def source_dirs(test):
+    """The directories of the program and of the libraries it depends on,
+    leaving out the libraries built for a target"""
+    dirs = [test.source_dir]
+    for dep in test.dependencies or []:
+        if dep.startswith(LIB_DIR) and isdir(dep):
+            dirs.append(dep)
+    return dirs
+
+
+def build(test, macros, cc, verbose=False):
+    includes = [HOST_DIR, MBED_API, MBED_HAL]
+    sources = list(MBED_SOURCES)
+    for d in source_dirs(test):
+        for root, _, files in walk(d):
+            includes.append(root)
+            # host.cpp has a notify_completion() without the LEDs
+            if d == TEST_MBED_LIB:
+                continue
+            sources.extend([join(root, f) for f in files
+                            if splitext(f)[1] in ('.c', '.cpp')])
+
+    build_dir = join(BUILD_DIR, "host", test.id)
+    mkdir(build_dir)
+    program = join(build_dir, "program")
+
+    # g++ compiles the C sources as C++ too, which the mbed headers allow
+    command = [cc, '-O2', '-g', '-Wall', '-Wextra', '-Wno-unused-parameter',
+               '-Wno-missing-field-initializers', '-o', program]
+    command += ['-D%s' % m for m in macros]
+    command += ['-I%s' % i for i in includes]
+    command += sources
+    command += ['-lrt']
+    cmd(command, verbose=verbose)
+    return program
+
+
+if __name__ == '__main__':
+    parser = OptionParser()
+    parser.add_option("-n", dest="program_name",
+                      help="The name of the test program, ie: BENCHMARK_8")
+    parser.add_option("-D", "", action="append", dest="macros", default=[],
+                      help="Add a macro definition")
+    parser.add_option("--cc", dest="cc", default="g++",
+                      help="The compiler of the PC")
+    parser.add_option("--build-only", action="store_true", dest="build_only",
+                      default=False, help="Do not run the program")
+    parser.add_option("-v", "--verbose", action="store_true", dest="verbose",
+                      default=False, help="Verbose diagnostic output")
+    (options, args) = parser.parse_args()
+
+    if options.program_name not in TEST_MAP:
+        args_error(parser, "[ERROR] Specify a test program with '-n'")
+    test = TEST_MAP[options.program_name]
+
+    program = build(test, options.macros, options.cc, options.verbose)
+    print "Built: %s" % program
+    if not options.build_only:
+        cmd([program], verbose=options.verbose)
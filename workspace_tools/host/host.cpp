@@ -0,0 +1,51 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "us_ticker_api.h"
+#include "FileHandle.h"
+
+/* The microsecond ticker, from the monotonic clock of the PC */
+us_timestamp_t us_ticker_read64(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (us_timestamp_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+uint32_t us_ticker_read(void) {
+    return (uint32_t)us_ticker_read64();
+}
+
+/* The console of mbed_printf, which retarget.cpp defines on a target */
+extern "C" int mbed_console_write(const char *data, size_t length) {
+    return fwrite(data, 1, length, stdout);
+}
+
+/* notify_completion() of libraries/tests/mbed/env, with the result as the
+ * exit status instead of a blinking LED */
+void notify_completion(bool success) {
+    printf("{{%s}}\n{{end}}\n", success ? "success" : "failure");
+    exit(success ? 0 : 1);
+}
+
+namespace mbed {
+
+/* Defined with the file handle table of retarget.cpp on a target */
+FileHandle::~FileHandle() {
+}
+
+} // namespace mbed
@@ -0,0 +1,33 @@
+/* mbed Microcontroller Library
+ * Copyright (c) 2006-2013 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MBED_H
+#define MBED_H
+
+/* The part of the mbed library which builds on a PC, see host.py */
+#include "platform.h"
+#include "error.h"
+#include "mbed_debug.h"
+#include "wait_api.h"
+#include "Timer.h"
+#include "FileSystemLike.h"
+#include "mbed_printf.h"
+
+#include <time.h>
+
+using namespace mbed;
+using namespace std;
+
+#endif
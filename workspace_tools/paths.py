@@ -68,6 +68,7 @@ UBLOX_LIBRARY = join(NET_LIBRARIES, "UbloxUSBModem")
 FS_PATH = join(LIB_DIR, "fs")
 FAT_FS = join(FS_PATH, "fat")
 SD_FS = join(FS_PATH, "sd")
+EMULATED_FS = join(FS_PATH, "emulated")
 
 # DSP
 DSP = join(LIB_DIR, "dsp")
@@ -15,12 +15,14 @@ See the License for the specific language governing permissions and
 limitations under the License.
 
 
-Utility to find which libraries could define a given symbol
+Utility to find which libraries could define a given symbol, and to read
+the constants of a linked program
 """
 from argparse import ArgumentParser
 from os.path import join, splitext
 from os import walk
 from subprocess import Popen, PIPE
+from struct import unpack_from
 
 
 OBJ_EXT = ['.o', '.a', '.ar']
@@ -64,6 +66,48 @@ def find_sym_in_path(sym, dir_path):
                 print path
 
 
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+
+class ElfImage:
+    """
+    The contents of the loaded sections of a 32-bit little endian ELF file,
+    by address
+    """
+    def __init__(self, path):
+        data = open(path, 'rb').read()
+        if data[:4] != b'\x7fELF' or data[4:6] != b'\x01\x01':
+            raise ValueError("%s is not a 32-bit little endian ELF file" % path)
+        
+        shoff, = unpack_from('<I', data, 0x20)
+        shentsize, shnum = unpack_from('<HH', data, 0x2E)
+        
+        self.sections = []
+        for i in range(shnum):
+            (name, type, flags, addr, offset, size,
+             link, info, align, entsize) = unpack_from('<10I', data, shoff + i * shentsize)
+            if type == SHT_PROGBITS and (flags & SHF_ALLOC) and size > 0:
+                self.sections.append((addr, data[offset:offset + size]))
+    
+    def read(self, address, size):
+        for addr, contents in self.sections:
+            if addr <= address and address + size <= addr + len(contents):
+                return contents[address - addr:address - addr + size]
+        return None
+    
+    def string_at(self, address):
+        """The NUL terminated string at address, or None if it is not in the image"""
+        for addr, contents in self.sections:
+            if addr <= address < addr + len(contents):
+                start = address - addr
+                end = contents.find(b'\x00', start)
+                if end < 0:
+                    return None
+                return contents[start:end].decode('latin-1')
+        return None
+
+
 if __name__ == '__main__':
     parser = ArgumentParser(description='Find Symbol')
     parser.add_argument('-s', '--sym',  required=True,
@@ -60,6 +60,9 @@ Wiring:
   * i2c_loop:
       * LPC1768: (p28 <-> p9), (p27 <-> p10)
 
+  * serial_loop:
+      * LPC1768: (p13 <-> p14)
+
   * i2c_eeprom:
       * LPC1*: (SDA=p28 , SCL=p27)
       * KL25Z: (SDA=PTE0, SCL=PTE1)
@@ -230,6 +233,26 @@ TESTS = [
         "source_dir": join(BENCHMARKS_DIR, "all"),
         "dependencies": [MBED_LIBRARIES]
     },
+    {
+        "id": "BENCHMARK_6", "description": "Serial::printf throughput",
+        "source_dir": join(BENCHMARKS_DIR, "serial_printf"),
+        "dependencies": [MBED_LIBRARIES]
+    },
+    {
+        "id": "BENCHMARK_7", "description": "Size (mbed_printf)",
+        "source_dir": join(BENCHMARKS_DIR, "mbed_printf"),
+        "dependencies": [MBED_LIBRARIES]
+    },
+    {
+        "id": "BENCHMARK_8", "description": "FAT file system",
+        "source_dir": join(BENCHMARKS_DIR, "fat_fs"),
+        "dependencies": [MBED_LIBRARIES, FAT_FS, EMULATED_FS]
+    },
+    {
+        "id": "BENCHMARK_9", "description": "FAT directory lookups",
+        "source_dir": join(BENCHMARKS_DIR, "fat_dir"),
+        "dependencies": [MBED_LIBRARIES, FAT_FS, EMULATED_FS]
+    },
     
     # Not automated MBED tests
     {
@@ -391,7 +414,81 @@ TESTS = [
         "source_dir": join(TEST_DIR, "mbed", "can_interrupt"),
         "dependencies": [MBED_LIBRARIES],
         "mcu": ["LPC1768", "LPC4088"]
+    },
+    {
+        "id": "MBED_31", "description": "Ticker event queue benchmark",
+        "source_dir": join(TEST_DIR, "mbed", "ticker_queue"),
+        "dependencies": [MBED_LIBRARIES],
+    },
+    {
+        "id": "MBED_32", "description": "Interrupt dispatch latency (InterruptManager)",
+        "source_dir": join(TEST_DIR, "mbed", "interrupt_dispatch"),
+        "dependencies": [MBED_LIBRARIES],
+    },
+    {
+        "id": "MBED_33", "description": "BusOut port coalescing",
+        "source_dir": join(TEST_DIR, "mbed", "bus_timing"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB],
+        "mcu": ["LPC1768"]
+    },
+    {
+        "id": "MBED_34", "description": "SPI block and DMA transfer (loopback)",
+        "source_dir": join(TEST_DIR, "mbed", "spi_transfer"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB],
+        "mcu": ["LPC1768"]
+    },
+    {
+        "id": "MBED_35", "description": "I2C transaction queue (TMP102)",
+        "source_dir": join(TEST_DIR, "mbed", "i2c_queue"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB],
+        "peripherals": ["TMP102"],
+        "mcu": ["LPC1768"]
+    },
+    {
+        "id": "MBED_36", "description": "BufferedSerial (loopback)",
+        "source_dir": join(TEST_DIR, "mbed", "buffered_serial"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB],
+        "peripherals": ["serial_loop"],
+        "mcu": ["LPC1768"]
     },	
+    {
+        "id": "MBED_37", "description": "Trace ring",
+        "source_dir": join(TEST_DIR, "mbed", "trace"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB],
+    },
+    {
+        "id": "MBED_38", "description": "File handle churn",
+        "source_dir": join(TEST_DIR, "mbed", "file_churn"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB],
+    },
+    {
+        "id": "MBED_39", "description": "SD multiple sector throughput",
+        "source_dir": join(TEST_DIR, "mbed", "sd_throughput"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, SD_FS, FAT_FS],
+        "peripherals": ["SD"]
+    },
+    {
+        "id": "MBED_40", "description": "FAT sector cache",
+        "source_dir": join(TEST_DIR, "mbed", "fat_cache"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, SD_FS, FAT_FS],
+        "peripherals": ["SD"]
+    },
+    {
+        "id": "MBED_41", "description": "FAT fast seek",
+        "source_dir": join(TEST_DIR, "mbed", "fat_fast_seek"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, FAT_FS],
+    },
+    {
+        "id": "MBED_42", "description": "FAT preallocated log file",
+        "source_dir": join(TEST_DIR, "mbed", "fat_prealloc"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB, SD_FS, FAT_FS],
+        "peripherals": ["SD"]
+    },
+    {
+        "id": "MBED_43", "description": "mbed_printf floating point",
+        "source_dir": join(TEST_DIR, "mbed", "printf_float"),
+        "dependencies": [MBED_LIBRARIES, TEST_MBED_LIB],
+    },
  
     # CMSIS RTOS tests
     {
@@ -486,6 +583,16 @@ TESTS = [
         "source_dir": join(TEST_DIR, "rtos", "mbed", "file"),
         "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, TEST_MBED_LIB, SD_FS, FAT_FS],
     },
+    {
+        "id": "RTOS_10", "description": "File and console I/O from two threads",
+        "source_dir": join(TEST_DIR, "rtos", "mbed", "file_threads"),
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, TEST_MBED_LIB, SD_FS, FAT_FS],
+    },
+    {
+        "id": "RTOS_11", "description": "Copies between SD and USB from two threads",
+        "source_dir": join(TEST_DIR, "rtos", "mbed", "fat_volumes"),
+        "dependencies": [MBED_LIBRARIES, RTOS_LIBRARIES, USB_HOST_LIBRARIES, TEST_MBED_LIB, SD_FS, FAT_FS],
+    },
     
     # Networking Tests
     {
@@ -0,0 +1,149 @@
+"""
+mbed SDK
+Copyright (c) 2011-2013 ARM Limited
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Decode the binary trace sent by trace_drain() (see mbed_trace.h), looking
+the format strings up in the ELF file of the program
+"""
+import sys
+import re
+from argparse import ArgumentParser
+from struct import pack, unpack, unpack_from
+from os.path import join, abspath, dirname
+
+ROOT = abspath(join(dirname(__file__), ".."))
+sys.path.append(ROOT)
+
+from workspace_tools.syms import ElfImage
+
+# Record layout, as in mbed_trace.h
+TRACE_VALID = 0x80000000
+TRACE_ARGS_SHIFT = 27
+TRACE_TIME_MASK = 0x07FFFFFF
+
+SPEC = re.compile(r'%([-+ 0#]*)(\d*|\*)(?:\.(\d*|\*))?(hh|h|ll|l|z|j|t|L)?([diuoxXcspfFeEgG%])')
+
+
+def format_record(elf, fmt, args):
+    """Format the arguments of a record, which are raw 32-bit words"""
+    args = list(args)
+    out = []
+    pos = 0
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, precision, _, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+
+        value = args.pop(0) if args else 0
+        spec = '%' + flags + width.replace('*', '')
+        if precision is not None:
+            spec += '.' + precision.replace('*', '')
+
+        if conv in 'di':
+            conv = 'd'
+            if value & 0x80000000:
+                value -= 1 << 32
+        elif conv == 'u':
+            conv = 'd'
+        elif conv == 'p':
+            spec, conv = '0x%08', 'x'
+        elif conv == 'c':
+            value = chr(value & 0xFF)
+        elif conv == 's':
+            s = elf.string_at(value)
+            value = s if s is not None else '<0x%08x>' % value
+        elif conv in 'fFeEgG':
+            conv = conv.replace('F', 'f')
+            value = unpack('<f', pack('<I', value))[0]
+        out.append((spec + conv) % value)
+    out.append(fmt[pos:])
+    return ''.join(out)
+
+
+class TraceDecoder:
+    """
+    Decodes a stream of trace records into lines of text. If the stream does
+    not start on a record, or bytes were lost, the decoder skips bytes until
+    it finds a header followed by the address of a string of the program.
+    """
+    def __init__(self, elf_path):
+        self.elf = ElfImage(elf_path)
+        self.data = b''
+        self.time = 0
+        self.last = None
+
+    def feed(self, data):
+        self.data += data
+        lines = []
+        while len(self.data) >= 8:
+            header, fmt_addr = unpack_from('<II', self.data)
+            nargs = (header >> TRACE_ARGS_SHIFT) & 0xF
+            fmt = self.elf.string_at(fmt_addr) if fmt_addr != 0 else None
+            if (not (header & TRACE_VALID) or
+                (fmt_addr != 0 and fmt is None) or
+                (fmt_addr == 0 and nargs != 1)):
+                self.data = self.data[1:]
+                continue
+
+            size = 8 + 4 * nargs
+            if len(self.data) < size:
+                break
+            args = unpack_from('<%dI' % nargs, self.data, 8)
+            self.data = self.data[size:]
+
+            if fmt_addr == 0:
+                # reported when read, not when the records were lost
+                lines.append("%12.6f *** %d records lost ***" % (self.time / 1e6, args[0]))
+                continue
+
+            t = header & TRACE_TIME_MASK
+            if self.last is None:
+                self.time = t
+            else:
+                self.time += (t - self.last) & TRACE_TIME_MASK
+            self.last = t
+            lines.append("%12.6f %s" % (self.time / 1e6, format_record(self.elf, fmt, args)))
+        return lines
+
+
+if __name__ == '__main__':
+    parser = ArgumentParser(description='Decode a binary trace')
+    parser.add_argument('-e', '--elf', required=True,
+                        help='The ELF file of the program')
+    parser.add_argument('-p', '--port',
+                        help='The serial port the trace is sent to (ie: COM3)')
+    parser.add_argument('-b', '--baud', type=int, default=921600,
+                        help='The baud rate of the serial port')
+    parser.add_argument('-f', '--file',
+                        help='A file the trace was saved to, instead of a serial port')
+    args = parser.parse_args()
+
+    decoder = TraceDecoder(args.elf)
+    if args.file:
+        for line in decoder.feed(open(args.file, 'rb').read()):
+            print(line)
+    elif args.port:
+        from serial import Serial
+        serial = Serial(args.port, args.baud, timeout=0.1)
+        while True:
+            for line in decoder.feed(serial.read(4096)):
+                print(line)
+            sys.stdout.flush()
+    else:
+        parser.error("give a serial port or a file")